@@ -0,0 +1,71 @@
+#include "TradeAggregator.h"
+
+#include <algorithm>
+
+namespace OrderEngine {
+
+    TradeAggregator::TradeAggregator()
+    {
+        const std::chrono::nanoseconds defaults[] = {std::chrono::seconds(1), std::chrono::minutes(1)};
+        SetIntervals(defaults, 2);
+    }
+
+    void TradeAggregator::SetIntervals(const std::chrono::nanoseconds* intervals, size_t count)
+    {
+        mStatistics = TradeStatistics{};
+        for (size_t i = 0; i < count && mStatistics.mIntervalCount < TradeStatistics::kMaxIntervals; ++i) {
+            if (intervals[i].count() <= 0) {
+                continue; // todo: log
+            }
+            mStatistics.mIntervalNs[mStatistics.mIntervalCount++] = intervals[i].count();
+        }
+    }
+
+    void TradeAggregator::startBar(TradeBar& bar, int64_t startNs, Base::Price price)
+    {
+        bar = TradeBar{};
+        bar.mStartNs = startNs;
+        bar.mOpen = price;
+        bar.mHigh = price;
+        bar.mLow = price;
+    }
+
+    void TradeAggregator::addToBar(TradeBar& bar, Base::Price price, Base::Quantity quantity, uint64_t trades)
+    {
+        bar.mHigh = std::max(bar.mHigh, price);
+        bar.mLow = std::min(bar.mLow, price);
+        bar.mClose = price;
+        bar.mVolume += quantity;
+        bar.mNotional += static_cast<double>(price) * static_cast<double>(quantity);
+        bar.mTradeCount += trades;
+    }
+
+    void TradeAggregator::Record(Base::Price price, Base::Quantity quantity, Base::Timestamp time, uint64_t trades)
+    {
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+
+        if (mStatistics.mSession.mTradeCount == 0) {
+            startBar(mStatistics.mSession, nowNs, price);
+        }
+        addToBar(mStatistics.mSession, price, quantity, trades);
+
+        for (uint32_t i = 0; i < mStatistics.mIntervalCount; ++i) {
+            const int64_t interval = mStatistics.mIntervalNs[i];
+            const int64_t startNs = nowNs - nowNs % interval;
+            TradeBar& current = mStatistics.mCurrent[i];
+
+            if (current.mTradeCount == 0 || current.mStartNs != startNs) {
+                if (current.mTradeCount != 0) {
+                    mStatistics.mPrevious[i] = current;
+                }
+                startBar(current, startNs, price);
+            }
+            addToBar(current, price, quantity, trades);
+        }
+    }
+
+    const TradeStatistics& TradeAggregator::GetStatistics() const
+    {
+        return mStatistics;
+    }
+} // namespace OrderEngine
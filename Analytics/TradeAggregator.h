@@ -0,0 +1,86 @@
+#pragma once
+#ifndef TRADE_AGGREGATOR_H
+#define TRADE_AGGREGATOR_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @struct TradeBar
+     * @brief OHLCV statistics of the fills within one interval (or the whole session).
+     * @details A bar with mTradeCount == 0 is empty, its prices are meaningless.
+     */
+    struct TradeBar
+    {
+        int64_t mStartNs{};         // Interval start, nanoseconds since the clock's epoch
+        Base::Price mOpen{};
+        Base::Price mHigh{};
+        Base::Price mLow{};
+        Base::Price mClose{};
+        Base::Quantity mVolume{};
+        double mNotional{};         // Sum of price * quantity
+        uint64_t mTradeCount{};
+
+        double GetVwap() const
+        {
+            return mVolume ? mNotional / static_cast<double>(mVolume) : 0.0;
+        }
+    };
+
+    /**
+     * @struct TradeStatistics
+     * @brief Plain copy of the aggregator's state, carried in DepthSnapshot.
+     * @details
+     * - mCurrent[i] is the bar in progress for mIntervalNs[i], mPrevious[i] the last completed one.
+     * - Bars roll on the first fill of a new interval. A reader that needs to know whether the
+     *   current bar is still open compares its mStartNs + interval with its own clock.
+     */
+    struct TradeStatistics
+    {
+        static constexpr size_t kMaxIntervals = 4;
+
+        TradeBar mSession;
+        uint32_t mIntervalCount{};
+        std::array<int64_t, kMaxIntervals> mIntervalNs{};
+        std::array<TradeBar, kMaxIntervals> mCurrent{};
+        std::array<TradeBar, kMaxIntervals> mPrevious{};
+    };
+
+    /**
+     * @class TradeAggregator
+     * @brief Incremental OHLCV/VWAP bars per book, so consumers do not rebuild them from the trade stream.
+     *
+     * @details
+     * - Fed by the book thread for every fill, O(1) per fill per interval and never allocates.
+     * - Fills of one level sweep share price and time, they are recorded in a single call.
+     * - The state is a TradeStatistics value, published with the depth snapshot.
+     */
+    class TradeAggregator
+    {
+    public:
+        TradeAggregator();
+
+        /**
+         * @brief Sets the bar intervals (at most kMaxIntervals, extra ones are ignored) and clears all bars.
+         */
+        void SetIntervals(const std::chrono::nanoseconds* intervals, size_t count);
+
+        /**
+         * @brief Records trades fills at price, quantity being their combined size.
+         */
+        void Record(Base::Price price, Base::Quantity quantity, Base::Timestamp time, uint64_t trades = 1);
+
+        const TradeStatistics& GetStatistics() const;
+
+    private:
+        TradeStatistics mStatistics;
+
+        static void startBar(TradeBar& bar, int64_t startNs, Base::Price price);
+        static void addToBar(TradeBar& bar, Base::Price price, Base::Quantity quantity, uint64_t trades);
+    };
+} // namespace OrderEngine
+
+#endif //TRADE_AGGREGATOR_H
@@ -0,0 +1,184 @@
+/**
+ * @file BookBenchmark.cpp
+ * @brief Micro benchmarks of the OrderBook hot path.
+ *
+ * Scenarios:
+ * - addOrder with depth snapshot publication off and on, the difference is the writer-side
+ *   publication cost.
+ * - addOrder with publication on while reader threads pull snapshots as fast as they can,
+ *   readers must not move the writer's numbers.
+ * - addOrder with the book containers and the orders in a hugepage arena on the local node.
+ * - addOrder on pro-rata and top-order books, against the FIFO baseline.
+ * - Aggressors sweeping a thin book many levels deep, the worst case for a single addOrder.
+ * - The FIFO and sweep cases again on a single-threaded book: no lock, plain counters.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../Order.h"
+#include "../OrderBook/OrderBook.h"
+
+namespace
+{
+    using namespace OrderEngine;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t kOrders = 1'000'000;
+    constexpr size_t kRestingWindow = 2'000; // Orders older than this are cancelled
+    constexpr Base::Price kMidPrice = 10'000;
+
+    struct OrderSpec
+    {
+        Base::OrderSide mSide;
+        Base::Price mPrice;
+        Base::Quantity mQty;
+    };
+
+    std::vector<OrderSpec> makeFlow()
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> offset(-50, 50);
+        std::uniform_int_distribution<Base::Quantity> qty(1, 100);
+
+        std::vector<OrderSpec> flow;
+        flow.reserve(kOrders);
+        for (size_t i = 0; i < kOrders; ++i) {
+            Base::OrderSide side = (rng() & 1) ? Base::OrderSide::BUY : Base::OrderSide::SELL;
+            // Mostly passive prices with some crossing flow
+            Base::Price price = kMidPrice + (side == Base::OrderSide::BUY ? -5 : 5) + offset(rng) / 5;
+            flow.push_back({side, price, qty(rng)});
+        }
+        return flow;
+    }
+
+    void printLatency(const char* name, std::vector<uint32_t>& samples, double seconds)
+    {
+        std::sort(samples.begin(), samples.end());
+        auto pct = [&](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+        std::printf("%-34s %9.0f ops/s  p50=%5uns p99=%6uns p99.9=%7uns max=%8uns\n",
+                    name, samples.size() / seconds, pct(0.50), pct(0.99), pct(0.999), samples.back());
+    }
+
+    template<typename MatchingPolicy = FifoPolicy, typename ConcurrencyPolicy = ThreadSafePolicy>
+    void runAddOrder(const char* name, const std::vector<OrderSpec>& flow, bool publish, size_t readers,
+                     Arena* arena = nullptr)
+    {
+        using Book = OrderBook<Order*, MatchingPolicy, ConcurrencyPolicy>;
+        Book book("BENCH", Book::kDefaultReservedLevels, arena);
+        book.setSnapshotPublishing(publish);
+
+        std::vector<Order, ArenaAllocator<Order>> orders{ArenaAllocator<Order>(arena)};
+        orders.reserve(flow.size());
+        for (size_t i = 0; i < flow.size(); ++i) {
+            orders.emplace_back(i + 1, "BENCH", flow[i].mSide, flow[i].mQty, flow[i].mPrice, 0);
+            orders.back().SetType(Base::OrderType::LIMIT);
+        }
+
+        std::atomic<bool> running{true};
+        std::atomic<uint64_t> snapshotsRead{0};
+        std::vector<std::thread> readerThreads;
+        for (size_t r = 0; r < readers; ++r) {
+            readerThreads.emplace_back([&] {
+                DepthSnapshot snapshot;
+                uint64_t reads = 0;
+                while (running.load(std::memory_order_relaxed)) {
+                    book.getDepthSnapshot(snapshot);
+                    ++reads;
+                }
+                snapshotsRead += reads;
+            });
+        }
+
+        std::vector<uint32_t> samples;
+        samples.reserve(flow.size());
+        auto start = Clock::now();
+        for (size_t i = 0; i < orders.size(); ++i) {
+            auto t0 = Clock::now();
+            book.addOrder(&orders[i]);
+            if (i >= kRestingWindow) {
+                book.cancelOrder(orders[i - kRestingWindow].GetId());
+            }
+            auto t1 = Clock::now();
+            samples.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        running = false;
+        for (auto& thread : readerThreads) {
+            thread.join();
+        }
+
+        printLatency(name, samples, seconds);
+        if (readers > 0) {
+            std::printf("%-34s %9.0f snapshots/s across %zu readers\n", "", snapshotsRead.load() / seconds, readers);
+        }
+    }
+
+    template<typename ConcurrencyPolicy = ThreadSafePolicy>
+    void runSweep(const char* name)
+    {
+        constexpr size_t kRounds = 10'000;
+        constexpr size_t kLevels = 100;
+        constexpr size_t kOrdersPerLevel = 5;
+        constexpr size_t kRestingPerRound = kLevels * kOrdersPerLevel;
+
+        OrderBook<Order*, FifoPolicy, ConcurrencyPolicy> book("BENCH");
+        book.setSnapshotPublishing(false);
+
+        std::vector<Order> orders;
+        orders.reserve(kRounds * (kRestingPerRound + 1));
+        std::vector<uint32_t> samples;
+        samples.reserve(kRounds);
+        Base::OrderId nextId = 1;
+
+        auto start = Clock::now();
+        for (size_t round = 0; round < kRounds; ++round) {
+            // Thin ask side: kLevels levels of kOrdersPerLevel small orders
+            for (size_t level = 0; level < kLevels; ++level) {
+                for (size_t i = 0; i < kOrdersPerLevel; ++i) {
+                    orders.emplace_back(nextId++, "BENCH", Base::OrderSide::SELL, 10, kMidPrice + static_cast<Base::Price>(level), 0);
+                    orders.back().SetType(Base::OrderType::LIMIT);
+                    book.addOrder(&orders.back());
+                }
+            }
+
+            // One buy taking the whole side
+            orders.emplace_back(nextId++, "BENCH", Base::OrderSide::BUY, kRestingPerRound * 10, kMidPrice + kLevels, 0);
+            orders.back().SetType(Base::OrderType::LIMIT);
+            auto t0 = Clock::now();
+            book.addOrder(&orders.back());
+            auto t1 = Clock::now();
+            samples.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printLatency(name, samples, seconds);
+    }
+}
+
+int main()
+{
+    auto flow = makeFlow();
+    std::printf("addOrder + cancel, %zu orders\n", flow.size());
+    runAddOrder("snapshots off", flow, false, 0);
+    runAddOrder("snapshots on", flow, true, 0);
+    runAddOrder("snapshots on, 3 readers", flow, true, 3);
+    runAddOrder<ProRataPolicy>("snapshots off, pro-rata", flow, false, 0);
+    runAddOrder<TopOrderProRataPolicy>("snapshots off, top order", flow, false, 0);
+    runSweep("sweep 100 levels x 5 orders");
+    runAddOrder<FifoPolicy, SingleThreadedPolicy>("snapshots off, single-threaded", flow, false, 0);
+    runSweep<SingleThreadedPolicy>("sweep, single-threaded");
+
+    ArenaConfig config;
+    config.mSize = flow.size() * sizeof(Order) + (size_t{64} << 20);
+    config.mNumaNode = Arena::CurrentNumaNode();
+    Arena arena(config);
+    runAddOrder("snapshots off, arena", flow, false, 0, &arena);
+    std::printf("%-34s pages=%c node=%d used=%zuMB heap fallbacks=%llu\n", "", static_cast<char>(arena.GetPageKind()),
+                arena.GetNumaNode(), arena.GetUsed() >> 20, static_cast<unsigned long long>(arena.GetHeapFallbacks()));
+    return 0;
+}
@@ -0,0 +1,557 @@
+/**
+ * @file TickToTrade.cpp
+ * @brief End-to-end latency harness: gateway -> engine -> report consumer over shared memory rings.
+ *
+ * Usage:
+ *   MatchingEngine_t2t [--count N] [--rate msgs/s] [--cpus producer,engine,consumer] [--wait spin|yield|park]
+ *                      [--producers N] [--dropcopy <file> [--csv] [--fsync-ms N]] [--journal <log>] [--stats NAME]
+ *
+ * Pinned threads exchange fixed-size binary messages through rings placed in a shared memory
+ * mapping, an MpscSequencer inbound and an SpscRing outbound:
+ * - producer : stamps and sends Command messages (unpaced, or paced with --rate). With
+ *              --producers N the flow is dealt round robin to N gateway threads, the extra
+ *              ones are left unpinned.
+ * - engine   : ingress -> risk gate -> decode -> validateOrder -> match -> encode reports to the outbound ring
+ * - consumer : receives ExecutionReports and measures the round trip
+ *
+ * The engine runs on a Runtime Worker, --wait picks how it idles between commands (see Worker.h).
+ * With --dropcopy every report is also published to a DropCopyWriter, which records it to the file
+ * from its own thread; the report stage then includes the publish.
+ * With --journal the engine appends every command to a command log under its sequencer sequence
+ * before applying it, so the log replays with MatchingEngine_replay; the inbound hop then
+ * includes the append.
+ * With --stats the book mirrors its counters into the shared memory segment NAME, for
+ * MatchingEngine_stats NAME to read while the harness runs.
+ * Every stage gets its own histogram, so a blown budget can be traced to the stage causing it.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+
+#include "../Monitoring/StatsSegment.h"
+#include "../Order.h"
+#include "../OrderBook/OrderBook.h"
+#include "../Protocol/Command.h"
+#include "../Protocol/CommandLog.h"
+#include "../Protocol/ExecutionReport.h"
+#include "../Risk/RiskGate.h"
+#include "../Runtime/Cpu.h"
+#include "../Runtime/Worker.h"
+#include "../Storage/DropCopyWriter.h"
+#include "../Transport/MpscSequencer.h"
+#include "../Transport/SpscRing.h"
+
+namespace
+{
+    using namespace OrderEngine;
+    // The book is owned by the engine shard's worker thread
+    using Book = OrderBook<Order*, FifoPolicy, SingleThreadedPolicy>;
+
+    constexpr size_t kRingCapacity = 1 << 16;
+    const Base::Symbol kSymbol = "T2T";
+
+    struct SharedRings
+    {
+        MpscSequencer<Command, kRingCapacity> mInbound;
+        SpscRing<ExecutionReport, kRingCapacity> mOutbound;
+        std::atomic<bool> mEngineDone{false};
+    };
+
+    enum Stage
+    {
+        INBOUND_HOP,    // Producer send -> engine ingress
+        RISK,           // Ingress -> pre-trade risk checks done
+        DECODE,         // Risk checked -> order decoded
+        VALIDATE,       // Decoded -> validateOrder done
+        MATCH,          // Validated -> book call returned
+        REPORT,         // Matched -> reports encoded and written to the outbound ring
+        TICK_TO_TRADE,  // Ingress -> reports written
+        ROUND_TRIP,     // Producer send -> report received by the consumer
+        kStageCount
+    };
+
+    const char* kStageNames[kStageCount] = {"inbound hop", "risk", "decode", "validate", "match", "report", "tick-to-trade", "round trip"};
+
+    uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Wraps around on machines with fewer CPUs than asked for
+    int availableCpu(int cpu)
+    {
+        return cpu % static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    void pinCurrentThread(int cpu)
+    {
+        if (!PinCurrentThread(availableCpu(cpu))) {
+            std::fprintf(stderr, "could not pin to cpu %d\n", cpu);
+        }
+    }
+
+    std::vector<Command> makeFlow(size_t count)
+    {
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> offset(-10, 10);
+        std::uniform_int_distribution<Base::Quantity> quantity(1, 200);
+        std::vector<Base::OrderId> live;
+        std::vector<Command> flow;
+        flow.reserve(count);
+
+        for (Base::OrderId id = 1; flow.size() < count; ++id) {
+            Command command{};
+            if (percent(rng) < 25 && !live.empty()) {
+                size_t pick = rng() % live.size();
+                command.mType = CommandType::CANCEL_ORDER;
+                command.mOrderId = live[pick];
+                live[pick] = live.back();
+                live.pop_back();
+            }
+            else {
+                command.mType = CommandType::ADD_ORDER;
+                command.mOrderId = id;
+                command.mSide = (rng() & 1) ? Base::OrderSide::BUY : Base::OrderSide::SELL;
+                command.mOrderType = Base::OrderType::LIMIT;
+                command.mTimeInForce = Base::TimeInForce::GTC;
+                command.mQuantity = quantity(rng);
+                command.mOwner = 1 + rng() % 16;
+                Base::Price edge = command.mSide == Base::OrderSide::BUY ? -2 : 2;
+                command.mPrice = 10'000 + edge + offset(rng);
+                live.push_back(id);
+            }
+            flow.push_back(command);
+        }
+        return flow;
+    }
+
+    void pushReport(SharedRings& rings, DropCopyWriter* dropCopy, const ExecutionReport& report)
+    {
+        while (!rings.mOutbound.TryPush(report)) {
+            CpuRelax();
+        }
+        if (dropCopy) {
+            dropCopy->Publish(report); // Never waits, a full queue shows up in the dropped count
+        }
+    }
+
+    void encodeFill(SharedRings& rings, DropCopyWriter* dropCopy, uint64_t sendNs, const Book::TradeExecution& trade,
+                    uint64_t& execId)
+    {
+        // One report per side of the fill
+        for (int i = 0; i < 2; ++i) {
+            Order* order = i == 0 ? trade.mInBoundOrder : trade.mRestingOrder;
+            Order* contra = i == 0 ? trade.mRestingOrder : trade.mInBoundOrder;
+            ExecutionReport report{};
+            report.mSendTimestampNs = sendNs;
+            report.mOrderId = order->GetId();
+            report.mContraOrderId = contra->GetId();
+            report.mPrice = trade.mPrice;
+            report.mLastQuantity = trade.mQuantity;
+            report.mLeavesQuantity = order->GetOpenQuantity();
+            report.mExecId = ++execId;
+            report.mExecType = ExecType::TRADE;
+            report.mStatus = order->GetOrderStatus();
+            report.mSide = order->GetSide();
+            pushReport(rings, dropCopy, report);
+        }
+    }
+
+    /**
+     * Engine shard: book, risk gate and report encoding, polled by a Runtime Worker.
+     * Each poll takes at most one inbound command so every stage is timed per command.
+     */
+    class Engine
+    {
+    public:
+        Engine(SharedRings& rings, size_t count, std::vector<LatencyHistogram>& stages, DropCopyWriter* dropCopy,
+               CommandLogWriter* journal, BookStatsRecord* statsRecord)
+            : mRings(rings), mCount(count), mStages(stages), mDropCopy(dropCopy), mJournal(journal), mBook(kSymbol),
+              mOrdersById(count + 1, nullptr)
+        {
+            mBook.setSnapshotPublishing(false);
+            mBook.attachStatsRecord(statsRecord);
+            mOrders.reserve(count);
+            mTrades.reserve(1024);
+            mRiskGate.SetReferencePrice(0, 10'000);
+        }
+
+        size_t Poll()
+        {
+            MpscSequencer<Command, kRingCapacity>::Entry entry;
+            if (mReceived == mCount || !mRings.mInbound.TryPop(entry)) {
+                return 0;
+            }
+            mSequenceGaps += entry.mSequence != mReceived + 1;
+            // Journaled before it is applied, a gap or a failed write leaves the command unjournaled
+            if (mJournal && !mJournal->Append(entry.mSequence, entry.mMessage)) {
+                ++mUnjournaled;
+            }
+            process(entry.mMessage);
+            if (++mReceived == mCount) {
+                mRings.mEngineDone.store(true, std::memory_order_release);
+            }
+            return 1;
+        }
+
+        // Entries that did not carry the next sequence, must stay 0
+        uint64_t GetSequenceGaps() const
+        {
+            return mSequenceGaps;
+        }
+
+        // Commands the journal refused or failed to write, must stay 0
+        uint64_t GetUnjournaledCount() const
+        {
+            return mUnjournaled;
+        }
+
+    private:
+        SharedRings& mRings;
+        const size_t mCount;
+        std::vector<LatencyHistogram>& mStages;
+        DropCopyWriter* mDropCopy;
+        CommandLogWriter* mJournal;
+        Book mBook;
+        std::vector<Order> mOrders;
+        // Flow ids never exceed the command count, cancels find their order here to release its exposure
+        std::vector<Order*> mOrdersById;
+        std::vector<Book::TradeExecution> mTrades;
+        RiskGate mRiskGate;
+        uint64_t mExecId = 0;
+        uint64_t mSequenceGaps = 0;
+        uint64_t mUnjournaled = 0;
+        size_t mReceived = 0;
+
+        void process(const Command& command)
+        {
+            uint64_t tIngress = nowNs();
+
+            // ==== Risk: rejections never reach the book ====
+            RiskResult risk = mRiskGate.Check(command);
+            uint64_t tRisk = nowNs();
+            mStages[INBOUND_HOP].Record(tIngress - command.mTimestampNs);
+            mStages[RISK].Record(tRisk - tIngress);
+            if (risk != RiskResult::ACCEPTED) {
+                ExecutionReport report{};
+                report.mSendTimestampNs = command.mTimestampNs;
+                report.mOrderId = command.mOrderId;
+                report.mExecId = ++mExecId;
+                report.mExecType = ExecType::REJECTED;
+                report.mStatus = Base::OrderStatus::REJECTED;
+                report.mSide = command.mSide;
+                pushReport(mRings, mDropCopy, report);
+                mStages[TICK_TO_TRADE].Record(nowNs() - tIngress);
+                return;
+            }
+
+            // ==== Decode ====
+            Order* order = nullptr;
+            if (command.mType == CommandType::ADD_ORDER) {
+                order = &mOrders.emplace_back(command.mOrderId, kSymbol, command.mSide, command.mQuantity,
+                                              command.mPrice, command.mStopPrice);
+                order->SetType(command.mOrderType);
+                order->SetTimeInForce(command.mTimeInForce);
+                order->SetOwner(command.mOwner);
+                mOrdersById[command.mOrderId] = order;
+            }
+            uint64_t tDecoded = nowNs();
+
+            // ==== Validate ====
+            bool valid = order ? mBook.validateOrder(order) : true;
+            uint64_t tValidated = nowNs();
+
+            // ==== Match ====
+            bool cancelled = false;
+            if (order) {
+                mBook.addOrder(order, static_cast<Base::OrderConditions>(command.mConditions));
+            }
+            else {
+                cancelled = mBook.cancelOrder(command.mOrderId);
+            }
+            uint64_t tMatched = nowNs();
+
+            // ==== Encode reports, release the exposure of what filled or left the book ====
+            mBook.drainTrades(mTrades);
+            for (const auto& trade : mTrades) {
+                encodeFill(mRings, mDropCopy, command.mTimestampNs, trade, mExecId);
+                mRiskGate.Release(trade.mInBoundOrder->GetOwner(), trade.mInBoundOrder->GetPrice(), trade.mQuantity);
+                mRiskGate.Release(trade.mRestingOrder->GetOwner(), trade.mRestingOrder->GetPrice(), trade.mQuantity);
+            }
+            if (!mTrades.empty()) {
+                mRiskGate.SetReferencePrice(0, mTrades.back().mPrice);
+            }
+            if (order && (order->GetOrderStatus() == Base::OrderStatus::CANCELLED
+                          || order->GetOrderStatus() == Base::OrderStatus::REJECTED)) {
+                mRiskGate.Release(order->GetOwner(), order->GetPrice(), order->GetOpenQuantity());
+            }
+            if (cancelled && mOrdersById[command.mOrderId]) {
+                Order* cancelledOrder = mOrdersById[command.mOrderId];
+                mRiskGate.Release(cancelledOrder->GetOwner(), cancelledOrder->GetPrice(), cancelledOrder->GetOpenQuantity());
+            }
+            if (mTrades.empty()) {
+                ExecutionReport report{};
+                report.mSendTimestampNs = command.mTimestampNs;
+                report.mOrderId = command.mOrderId;
+                report.mExecId = ++mExecId;
+                if (order) {
+                    report.mExecType = valid ? ExecType::NEW : ExecType::REJECTED;
+                    report.mPrice = order->GetPrice();
+                    report.mLeavesQuantity = order->GetOpenQuantity();
+                    report.mStatus = order->GetOrderStatus();
+                    report.mSide = order->GetSide();
+                }
+                else {
+                    report.mExecType = cancelled ? ExecType::CANCELED : ExecType::REJECTED;
+                    report.mStatus = cancelled ? Base::OrderStatus::CANCELLED : Base::OrderStatus::REJECTED;
+                }
+                pushReport(mRings, mDropCopy, report);
+            }
+            mTrades.clear();
+            uint64_t tReported = nowNs();
+
+            mStages[DECODE].Record(tDecoded - tRisk);
+            mStages[VALIDATE].Record(tValidated - tDecoded);
+            mStages[MATCH].Record(tMatched - tValidated);
+            mStages[REPORT].Record(tReported - tMatched);
+            mStages[TICK_TO_TRADE].Record(tReported - tIngress);
+        }
+    };
+
+    void runConsumer(SharedRings& rings, int cpu, LatencyHistogram& roundTrip, uint64_t& reports)
+    {
+        pinCurrentThread(cpu);
+
+        ExecutionReport report;
+        uint64_t lastSend = 0;
+        for (;;) {
+            if (rings.mOutbound.TryPop(report)) {
+                ++reports;
+                // Round trip is measured once per command, on its first report
+                if (report.mSendTimestampNs != lastSend) {
+                    roundTrip.Record(nowNs() - report.mSendTimestampNs);
+                    lastSend = report.mSendTimestampNs;
+                }
+                continue;
+            }
+            if (rings.mEngineDone.load(std::memory_order_acquire) && rings.mOutbound.Size() == 0) {
+                break;
+            }
+            CpuRelax();
+        }
+    }
+
+    // Sends flow[first], flow[first + stride], ... at rate / stride each, so all producers add up to rate
+    void runProducer(SharedRings& rings, std::vector<Command>& flow, size_t first, size_t stride, double rate, int cpu,
+                     Worker& engine)
+    {
+        if (cpu >= 0) {
+            pinCurrentThread(cpu);
+        }
+
+        const uint64_t interval = rate > 0 ? static_cast<uint64_t>(1e9 * stride / rate) : 0;
+        uint64_t next = nowNs();
+        for (size_t i = first; i < flow.size(); i += stride) {
+            if (interval) {
+                while (nowNs() < next) {
+                    CpuRelax();
+                }
+                next += interval;
+            }
+            Command& command = flow[i];
+            command.mTimestampNs = nowNs();
+            while (rings.mInbound.TryPublish(command) == 0) {
+                CpuRelax();
+            }
+            engine.Notify();
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = 1'000'000;
+    double rate = 0;
+    int cpus[3] = {0, 1, 2};
+    WaitMode waitMode = WaitMode::BUSY_SPIN;
+    size_t producerCount = 1;
+    const char* dropCopyPath = nullptr;
+    DropCopyConfig dropCopyConfig;
+    const char* journalPath = nullptr;
+    const char* statsSegment = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--cpus") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%d,%d,%d", &cpus[0], &cpus[1], &cpus[2]) != 3) {
+                std::fprintf(stderr, "--cpus expects producer,engine,consumer\n");
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) {
+            producerCount = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--dropcopy") == 0 && i + 1 < argc) {
+            dropCopyPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0) {
+            dropCopyConfig.mFormat = DropCopyFormat::CSV;
+        }
+        else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journalPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+            statsSegment = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--fsync-ms") == 0 && i + 1 < argc) {
+            dropCopyConfig.mFsyncIntervalNs = std::strtoull(argv[++i], nullptr, 10) * 1'000'000;
+        }
+        else if (std::strcmp(argv[i], "--wait") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (std::strcmp(mode, "spin") == 0) {
+                waitMode = WaitMode::BUSY_SPIN;
+            }
+            else if (std::strcmp(mode, "yield") == 0) {
+                waitMode = WaitMode::SPIN_YIELD;
+            }
+            else if (std::strcmp(mode, "park") == 0) {
+                waitMode = WaitMode::SPIN_PARK;
+            }
+            else {
+                std::fprintf(stderr, "--wait expects spin, yield or park\n");
+                return 2;
+            }
+        }
+        else {
+            std::fprintf(stderr, "usage: MatchingEngine_t2t [--count N] [--rate msgs/s] [--cpus p,e,c] [--wait spin|yield|park] [--producers N]\n"
+                                 "                         [--dropcopy <file> [--csv] [--fsync-ms N]] [--journal <log>] [--stats NAME]\n");
+            return 2;
+        }
+    }
+
+    // Rings live in a shared mapping, the same layout works between processes
+    void* memory = mmap(nullptr, sizeof(SharedRings), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::perror("mmap");
+        return 1;
+    }
+    auto* rings = new (memory) SharedRings();
+
+    auto flow = makeFlow(count);
+    std::vector<LatencyHistogram> stages(kStageCount);
+    uint64_t reports = 0;
+
+    std::unique_ptr<DropCopyWriter> dropCopy;
+    std::unique_ptr<CommandLogWriter> journal;
+    std::unique_ptr<StatsSegment> stats;
+    try {
+        if (dropCopyPath) {
+            dropCopy = std::make_unique<DropCopyWriter>(dropCopyPath, dropCopyConfig);
+        }
+        if (journalPath) {
+            journal = std::make_unique<CommandLogWriter>(journalPath);
+            journal->AddBook(kSymbol); // Book 0, the flow's Command::mBook
+        }
+        if (statsSegment) {
+            stats = std::make_unique<StatsSegment>(StatsSegment::Create(statsSegment, 1));
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    Engine engine(*rings, count, stages, dropCopy.get(), journal.get(), stats ? stats->AddBook(kSymbol) : nullptr);
+    WorkerConfig config;
+    config.mName = "engine";
+    config.mCpu = availableCpu(cpus[1]);
+    config.mWaitMode = waitMode;
+    Worker worker(config, [&engine] { return engine.Poll(); });
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer(runConsumer, std::ref(*rings), cpus[2], std::ref(stages[ROUND_TRIP]), std::ref(reports));
+    worker.Start();
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producerCount; ++i) {
+        producers.emplace_back(runProducer, std::ref(*rings), std::ref(flow), i, producerCount, rate, i == 0 ? cpus[0] : -1,
+                               std::ref(worker));
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    while (!rings->mEngineDone.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    worker.RequestStop();
+    worker.Join();
+    consumer.join();
+    if (dropCopy) {
+        dropCopy->Close();
+    }
+    bool journalClosed = !journal || journal->Close();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const WorkerStats& engineStats = worker.GetStats();
+    std::printf("%zu commands, %llu reports in %.3fs (%.0f commands/s), cpus %d/%d/%d\n", count,
+                static_cast<unsigned long long>(reports), seconds, count / seconds, cpus[0], cpus[1], cpus[2]);
+    std::printf("%zu producers, %llu sequence gaps\n", producerCount,
+                static_cast<unsigned long long>(engine.GetSequenceGaps()));
+    if (journal) {
+        std::printf("journal %s: last sequence %llu, %llu commands not journaled\n", journalPath,
+                    static_cast<unsigned long long>(journal->GetLastSequence()),
+                    static_cast<unsigned long long>(engine.GetUnjournaledCount()));
+        if (!journalClosed) {
+            std::printf("journal FAILED: %s, the log is unusable\n", std::strerror(journal->GetError()));
+        }
+    }
+    std::printf("engine wait %s, duty cycle %.1f%%, %llu yields, %llu parks\n", WaitModeToString(waitMode),
+                100.0 * engineStats.GetDutyCycle(), static_cast<unsigned long long>(engineStats.mYields.load()),
+                static_cast<unsigned long long>(engineStats.mParks.load()));
+    if (dropCopy) {
+        const DropCopyStats& copy = dropCopy->GetStats();
+        std::printf("drop copy %s: %llu records, %llu bytes in %llu writes, %llu syncs, %llu dropped, %llu errors\n",
+                    dropCopy->IsUsingIoUring() ? "io_uring" : "pwrite",
+                    static_cast<unsigned long long>(copy.mRecords.load()),
+                    static_cast<unsigned long long>(copy.mBytesWritten.load()),
+                    static_cast<unsigned long long>(copy.mBatches.load()),
+                    static_cast<unsigned long long>(copy.mSyncs.load()),
+                    static_cast<unsigned long long>(copy.GetDropped()),
+                    static_cast<unsigned long long>(copy.mErrors.load()));
+        if (dropCopy->IsFailed()) {
+            std::printf("drop copy FAILED: %s, %llu bytes known durable\n", std::strerror(dropCopy->GetError()),
+                        static_cast<unsigned long long>(copy.mSyncedBytes.load()));
+        }
+    }
+    std::printf("%-14s %8s %8s %8s %8s %10s\n", "stage (ns)", "p50", "p90", "p99", "p99.9", "max");
+    for (size_t i = 0; i < kStageCount; ++i) {
+        const LatencyHistogram& h = stages[i];
+        std::printf("%-14s %8llu %8llu %8llu %8llu %10llu\n", kStageNames[i],
+                    static_cast<unsigned long long>(h.Percentile(0.50)),
+                    static_cast<unsigned long long>(h.Percentile(0.90)),
+                    static_cast<unsigned long long>(h.Percentile(0.99)),
+                    static_cast<unsigned long long>(h.Percentile(0.999)),
+                    static_cast<unsigned long long>(h.Percentile(1.0)));
+    }
+
+    rings->~SharedRings();
+    munmap(memory, sizeof(SharedRings));
+    return 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#ifndef LOG_H
+#define LOG_H
+
+#include <iostream>
+
+/*
+ * Trace logging of book internals.
+ * Compiled out unless ORDER_ENGINE_VERBOSE is defined, so the matching path does not pay
+ * for stream formatting in normal builds.
+ * Usage: ORDER_ENGINE_TRACE("[INFO][OrderTracker][AddOrder]: qty=" << qty);
+*/
+#ifdef ORDER_ENGINE_VERBOSE
+#define ORDER_ENGINE_TRACE(expr) (std::cout << expr << std::endl)
+#else
+#define ORDER_ENGINE_TRACE(expr) ((void)0)
+#endif
+
+#endif // LOG_H
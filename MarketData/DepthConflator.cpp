@@ -0,0 +1,158 @@
+#include "DepthConflator.h"
+
+#include <stdexcept>
+
+namespace OrderEngine {
+
+    static bool sameLevel(const Base::LevelInfo& a, const Base::LevelInfo& b)
+    {
+        return a.mPrice == b.mPrice && a.mQuantity == b.mQuantity && a.mOrderCount == b.mOrderCount;
+    }
+
+    // Copies the valid ranks of one side and zeroes the rest, returns a bit per rank that differs from out
+    template<size_t Depth>
+    static uint32_t copySide(const std::array<Base::LevelInfo, Depth>& levels, uint32_t levelCount,
+                             std::array<Base::LevelInfo, Depth>& out)
+    {
+        uint32_t changed = 0;
+        for (uint32_t rank = 0; rank < Depth; ++rank) {
+            Base::LevelInfo level = rank < levelCount ? levels[rank] : Base::LevelInfo{};
+            if (!sameLevel(level, out[rank])) {
+                out[rank] = level;
+                changed |= 1u << rank;
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * One book's feed: diffs each snapshot against the previous one and publishes the ranks.
+     * mLast and mSequence are only touched by the book's thread, readers go through mLatest.
+     */
+    class DepthConflator::BookFeed : public DepthListener
+    {
+    public:
+        BookFeed(DepthConflator& owner, uint16_t book)
+            : mOwner(owner), mBook(book)
+        {
+        }
+
+        void onDepthUpdate(const DepthSnapshot& snapshot) override
+        {
+            uint32_t changed = copySide(snapshot.mBids, snapshot.mBidLevels, mLast.mBids);
+            changed |= copySide(snapshot.mAsks, snapshot.mAskLevels, mLast.mAsks) << kAskShift;
+            if (changed == 0) {
+                return; // Nothing in the top ranks moved, e.g. a change deeper in the book
+            }
+            mLast.mVersion = snapshot.mVersion;
+            mLast.mSequence = mSequence;
+            mLatest.BeginWrite() = mLast;
+            mLatest.EndWrite();
+            // Published before marking, a reader that sees the bit also sees these ranks
+            mOwner.markDirty(mBook, changed);
+        }
+
+        void ReadLatest(BookDepth& depth) const
+        {
+            mLatest.Read(depth);
+        }
+
+        void SetSequence(uint64_t sequence)
+        {
+            mSequence = sequence;
+        }
+
+    private:
+        DepthConflator& mOwner;
+        const uint16_t mBook;
+        BookDepth mLast{};
+        uint64_t mSequence = 0;
+        SnapshotPublisher<BookDepth> mLatest;
+    };
+
+    DepthConflator::DepthConflator(size_t bookCount, size_t subscriberCount)
+    {
+        if (bookCount > kMaxBooks) {
+            throw std::runtime_error("DepthConflator: too many books");
+        }
+        for (size_t i = 0; i < bookCount; ++i) {
+            mBooks.push_back(std::make_unique<BookFeed>(*this, static_cast<uint16_t>(i)));
+        }
+        for (size_t i = 0; i < subscriberCount; ++i) {
+            auto subscriber = std::make_unique<Subscriber>();
+            subscriber->mDirtyLevels = std::make_unique<std::atomic<uint32_t>[]>(bookCount);
+            for (size_t book = 0; book < bookCount; ++book) {
+                subscriber->mDirtyLevels[book].store(0, std::memory_order_relaxed);
+            }
+            mSubscribers.push_back(std::move(subscriber));
+        }
+    }
+
+    DepthConflator::~DepthConflator() = default;
+
+    DepthListener& DepthConflator::GetBookListener(uint16_t book)
+    {
+        return *mBooks[book];
+    }
+
+    void DepthConflator::SetInputSequence(uint16_t book, uint64_t sequence)
+    {
+        mBooks[book]->SetSequence(sequence);
+    }
+
+    void DepthConflator::markDirty(uint16_t book, uint32_t changedRanks)
+    {
+        for (auto& subscriber : mSubscribers) {
+            uint32_t pending = subscriber->mDirtyLevels[book].fetch_or(changedRanks, std::memory_order_acq_rel);
+            if (pending == 0) {
+                // Already flagged otherwise: pending ranks mean the book bit is set or being read
+                subscriber->mDirtyBooks.fetch_or(uint64_t{1} << book, std::memory_order_release);
+            }
+            else if (uint32_t overwritten = pending & changedRanks) {
+                subscriber->mConflated.fetch_add(__builtin_popcount(overwritten), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t DepthConflator::Read(size_t subscriber, std::vector<DepthLevelUpdate>& updates)
+    {
+        Subscriber& state = *mSubscribers[subscriber];
+        uint64_t books = state.mDirtyBooks.exchange(0, std::memory_order_acquire);
+        size_t before = updates.size();
+        BookDepth depth;
+
+        while (books != 0) {
+            auto book = static_cast<uint16_t>(__builtin_ctzll(books));
+            books &= books - 1;
+            uint32_t ranks = state.mDirtyLevels[book].exchange(0, std::memory_order_acq_rel);
+            if (ranks == 0) {
+                continue;
+            }
+            mBooks[book]->ReadLatest(depth);
+            while (ranks != 0) {
+                uint32_t bit = __builtin_ctz(ranks);
+                ranks &= ranks - 1;
+                bool isAsk = bit >= kAskShift;
+                auto rank = static_cast<uint8_t>(isAsk ? bit - kAskShift : bit);
+                updates.push_back({depth.mVersion, depth.mSequence, book, isAsk ? Base::OrderSide::SELL : Base::OrderSide::BUY, rank,
+                                   isAsk ? depth.mAsks[rank] : depth.mBids[rank]});
+            }
+        }
+        return updates.size() - before;
+    }
+
+    uint64_t DepthConflator::GetConflatedCount(size_t subscriber) const
+    {
+        return mSubscribers[subscriber]->mConflated.load(std::memory_order_relaxed);
+    }
+
+    size_t DepthConflator::GetBookCount() const
+    {
+        return mBooks.size();
+    }
+
+    size_t DepthConflator::GetSubscriberCount() const
+    {
+        return mSubscribers.size();
+    }
+} // namespace OrderEngine
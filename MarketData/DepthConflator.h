@@ -0,0 +1,114 @@
+#pragma once
+#ifndef DEPTH_CONFLATOR_H
+#define DEPTH_CONFLATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../OrderTypes.h"
+#include "../OrderBook/DepthSnapshot.h"
+#include "../OrderBook/SnapshotPublisher.h"
+
+namespace OrderEngine {
+    /**
+     * @struct DepthLevelUpdate
+     * @brief Latest state of one depth rank, what a subscriber reads.
+     * @details A rank the book no longer fills comes out with price, quantity and order count 0.
+     */
+    struct DepthLevelUpdate
+    {
+        uint64_t mVersion;      // Book snapshot version the state was taken from
+        uint64_t mSequence;     // Input sequence of the command that produced the state, 0 if not set
+        uint16_t mBook;
+        Base::OrderSide mSide;
+        uint8_t mRank;          // 0 is the best price
+        Base::LevelInfo mLevel;
+    };
+
+    /**
+     * @class DepthConflator
+     * @brief Per-subscriber conflation of book depth for consumers that may fall behind.
+     *
+     * @details
+     * - Listens to each book's depth output (OrderBook::setDepthListener). On every snapshot the
+     *   book's thread diffs the top kDepth ranks against the previous snapshot, publishes the
+     *   new ranks and ORs the changed ones into each subscriber's dirty-level bitmap for that book.
+     * - A read takes a subscriber's dirty bitmaps and emits the latest state of each marked rank,
+     *   however many times it changed since the last read. Fast readers see every change, slow
+     *   readers see fewer, newer ones.
+     * - Memory is fixed at construction: one bitmap per book and subscriber plus one depth copy
+     *   per book. Nothing is queued, so a reader that stops never slows or blocks a book; the
+     *   book side cost is the diff and a couple of atomic ORs per subscriber.
+     * - Each book feeds from its own thread, each subscriber reads from one thread at a time.
+     *   A read may repeat a state it already emitted, never misses the latest one.
+     */
+    class DepthConflator
+    {
+    public:
+        static constexpr size_t kMaxBooks = 64;
+        static constexpr size_t kDepth = DepthSnapshot::kDepth;
+
+        /**
+         * @throws std::runtime_error with more than kMaxBooks books
+         */
+        DepthConflator(size_t bookCount, size_t subscriberCount);
+        ~DepthConflator();
+        DepthConflator(const DepthConflator&) = delete;
+        DepthConflator& operator=(const DepthConflator&) = delete;
+
+        // Listener to attach to book index book with OrderBook::setDepthListener
+        DepthListener& GetBookListener(uint16_t book);
+
+        /**
+         * @brief Input sequence of the command book is about to apply, stamped on the depth it produces.
+         * @details Called from the book's thread before the book call, lets subscribers line depth up
+         *          with the journal and spot sequence gaps.
+         */
+        void SetInputSequence(uint16_t book, uint64_t sequence);
+
+        /**
+         * @brief Appends the latest state of every rank that changed since the subscriber's last read.
+         * @details Updates come out per book, bids then asks, best rank first.
+         * @return Number of updates appended
+         */
+        size_t Read(size_t subscriber, std::vector<DepthLevelUpdate>& updates);
+
+        // Rank changes that were overwritten before the subscriber read them
+        uint64_t GetConflatedCount(size_t subscriber) const;
+
+        size_t GetBookCount() const;
+        size_t GetSubscriberCount() const;
+
+    private:
+        // Ranks as published, unused ranks zeroed
+        struct BookDepth
+        {
+            uint64_t mVersion;
+            uint64_t mSequence;
+            std::array<Base::LevelInfo, kDepth> mBids;
+            std::array<Base::LevelInfo, kDepth> mAsks;
+        };
+
+        class BookFeed;
+
+        // Per subscriber, on its own cache lines: books write it, its reader clears it
+        struct alignas(64) Subscriber
+        {
+            std::atomic<uint64_t> mDirtyBooks{0};      // Bit per book with dirty ranks
+            std::atomic<uint64_t> mConflated{0};
+            std::unique_ptr<std::atomic<uint32_t>[]> mDirtyLevels; // Per book: bid ranks in bits 0-15, asks from kAskShift
+        };
+
+        static constexpr uint32_t kAskShift = 16;
+        static_assert(kDepth <= kAskShift, "Ranks of one side must fit in half a bitmap word");
+
+        std::vector<std::unique_ptr<BookFeed>> mBooks;
+        std::vector<std::unique_ptr<Subscriber>> mSubscribers;
+
+        void markDirty(uint16_t book, uint32_t changedRanks);
+    };
+} // namespace OrderEngine
+
+#endif //DEPTH_CONFLATOR_H
@@ -0,0 +1,200 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace OrderEngine {
+
+#ifdef __linux__
+    // From <linux/mempolicy.h>, spelled out to avoid a libnuma dependency
+    static constexpr int kMpolBind = 2;
+    static constexpr unsigned kMpolMfMove = 1u << 1;
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+    static constexpr size_t k2MB = size_t{2} << 20;
+    static constexpr size_t k1GB = size_t{1} << 30;
+
+    static size_t roundUp(size_t value, size_t granularity)
+    {
+        return (value + granularity - 1) / granularity * granularity;
+    }
+
+    static void* mapAnonymous(size_t size, int extraFlags)
+    {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    Arena::Arena(const ArenaConfig& config)
+        : mNumaNode(config.mNumaNode)
+    {
+        // ==== Reserve: 1GB pages, then 2MB pages, then normal pages ====
+#ifdef MAP_HUGETLB
+        if (config.mUseHugePages && config.mSize >= k1GB) {
+            mCapacity = roundUp(config.mSize, k1GB);
+            mBase = static_cast<char*>(mapAnonymous(mCapacity, MAP_HUGETLB | (30 << MAP_HUGE_SHIFT)));
+            mPageKind = PageKind::HUGE_1GB;
+        }
+        if (!mBase && config.mUseHugePages) {
+            mCapacity = roundUp(config.mSize, k2MB);
+            mBase = static_cast<char*>(mapAnonymous(mCapacity, MAP_HUGETLB | (21 << MAP_HUGE_SHIFT)));
+            mPageKind = PageKind::HUGE_2MB;
+        }
+#endif
+        if (!mBase) {
+            mCapacity = roundUp(config.mSize, k2MB);
+            mBase = static_cast<char*>(mapAnonymous(mCapacity, 0));
+            mPageKind = PageKind::NORMAL;
+            if (!mBase) {
+                throw std::bad_alloc();
+            }
+#ifdef MADV_HUGEPAGE
+            // No reserved hugepages: ask for transparent ones instead
+            if (config.mUseHugePages) {
+                madvise(mBase, mCapacity, MADV_HUGEPAGE);
+            }
+#endif
+        }
+
+        // ==== Bind to the worker's node before the first touch places the pages ====
+#ifdef __linux__
+        if (mNumaNode >= 0 && mNumaNode < 64) {
+            unsigned long nodeMask = 1ul << mNumaNode;
+            if (syscall(SYS_mbind, mBase, mCapacity, kMpolBind, &nodeMask, 64, kMpolMfMove) != 0) {
+                mNumaNode = -1; // Not a NUMA machine or node unavailable, keep default placement
+            }
+        }
+#else
+        mNumaNode = -1;
+#endif
+
+        // ==== Pre-fault every page ====
+        if (config.mPrefault) {
+            size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            for (size_t offset = 0; offset < mCapacity; offset += pageSize) {
+                static_cast<volatile char*>(mBase)[offset] = 0;
+            }
+        }
+    }
+
+    Arena::~Arena()
+    {
+        if (mBase) {
+            munmap(mBase, mCapacity);
+        }
+    }
+
+    size_t Arena::classOf(size_t bytes)
+    {
+        size_t bits = kMinClassBits;
+        while ((size_t{1} << bits) < bytes) {
+            ++bits;
+        }
+        return bits - kMinClassBits;
+    }
+
+    bool Arena::owns(const void* ptr) const
+    {
+        auto* p = static_cast<const char*>(ptr);
+        return p >= mBase && p < mBase + mCapacity;
+    }
+
+    void* Arena::Allocate(size_t bytes, size_t alignment)
+    {
+        if (bytes == 0) {
+            bytes = 1;
+        }
+
+        size_t blockSize;
+        if (bytes <= (size_t{1} << kMaxClassBits)) {
+            size_t sizeClass = classOf(bytes);
+            if (FreeBlock* block = mFreeLists[sizeClass]) {
+                mFreeLists[sizeClass] = block->mNext;
+                return block;
+            }
+            // Class blocks are naturally aligned to their size
+            blockSize = size_t{1} << (sizeClass + kMinClassBits);
+            alignment = std::max(alignment, std::min<size_t>(blockSize, 64));
+        }
+        else {
+            blockSize = bytes;
+        }
+
+        size_t offset = roundUp(mUsed, alignment);
+        if (offset + blockSize > mCapacity) {
+            ++mHeapFallbacks;
+            return ::operator new(blockSize);
+        }
+        mUsed = offset + blockSize;
+        return mBase + offset;
+    }
+
+    void Arena::Deallocate(void* ptr, size_t bytes)
+    {
+        if (!ptr) {
+            return;
+        }
+        if (!owns(ptr)) {
+            ::operator delete(ptr);
+            return;
+        }
+        if (bytes == 0) {
+            bytes = 1;
+        }
+        if (bytes > (size_t{1} << kMaxClassBits)) {
+            return; // Large blocks are not recycled
+        }
+
+        size_t sizeClass = classOf(bytes);
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->mNext = mFreeLists[sizeClass];
+        mFreeLists[sizeClass] = block;
+    }
+
+    Arena::PageKind Arena::GetPageKind() const
+    {
+        return mPageKind;
+    }
+
+    int Arena::GetNumaNode() const
+    {
+        return mNumaNode;
+    }
+
+    size_t Arena::GetCapacity() const
+    {
+        return mCapacity;
+    }
+
+    size_t Arena::GetUsed() const
+    {
+        return mUsed;
+    }
+
+    uint64_t Arena::GetHeapFallbacks() const
+    {
+        return mHeapFallbacks;
+    }
+
+    int Arena::CurrentNumaNode()
+    {
+#if defined(__linux__) && defined(SYS_getcpu)
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+            return static_cast<int>(node);
+        }
+#endif
+        return -1;
+    }
+} // namespace OrderEngine
@@ -0,0 +1,144 @@
+#pragma once
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace OrderEngine {
+    /**
+     * @brief Backing memory requested for an Arena.
+     * - mSize         : Bytes to reserve up front, rounded up to the page size used
+     * - mNumaNode     : Node to bind the memory to, -1 keeps the default policy
+     * - mUseHugePages : Try 1GB then 2MB hugepages before falling back to normal pages
+     * - mPrefault     : Touch every page in the constructor, so trading never page faults
+     */
+    struct ArenaConfig
+    {
+        size_t mSize = size_t{64} << 20;
+        int mNumaNode = -1;
+        bool mUseHugePages = true;
+        bool mPrefault = true;
+    };
+
+    /**
+     * @class Arena
+     * @brief Per-shard memory arena for the containers of the books owned by one worker.
+     *
+     * @details
+     * - One mmap reservation, backed by hugepages when available, bound to the worker's NUMA
+     *   node and pre-faulted, so book memory is local, TLB friendly and never faults mid-session.
+     * - Allocation is a bump pointer plus free lists per power-of-two size class. Tree nodes and
+     *   queue buffers freed by the book are recycled by the next allocation of that class.
+     * - Blocks larger than the biggest class are bump allocated and not recycled.
+     * - When the reservation runs out, allocations fall back to the global heap and are counted.
+     * - Not thread safe: an arena belongs to one shard and is used under that shard's book thread.
+     */
+    class Arena
+    {
+    public:
+        enum class PageKind : char
+        {
+            HUGE_1GB = 'G',
+            HUGE_2MB = 'M',
+            NORMAL = 'N'
+        };
+
+        explicit Arena(const ArenaConfig& config);
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(size_t bytes, size_t alignment);
+        void Deallocate(void* ptr, size_t bytes);
+
+        // Constructs an object (e.g. an Order) in the arena
+        template<typename T, typename... Args> T* New(Args&&... args)
+        {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T> void Delete(T* object)
+        {
+            if (object) {
+                object->~T();
+                Deallocate(object, sizeof(T));
+            }
+        }
+
+        PageKind GetPageKind() const;
+        int GetNumaNode() const;
+        size_t GetCapacity() const;
+        size_t GetUsed() const;            // Bytes handed out by the bump pointer so far
+        uint64_t GetHeapFallbacks() const; // Allocations served by the global heap
+
+        // NUMA node of the CPU the calling thread runs on, -1 if unknown
+        static int CurrentNumaNode();
+
+    private:
+        static constexpr size_t kMinClassBits = 4;  // 16 bytes
+        static constexpr size_t kMaxClassBits = 20; // 1MB
+        static constexpr size_t kClasses = kMaxClassBits - kMinClassBits + 1;
+
+        struct FreeBlock
+        {
+            FreeBlock* mNext;
+        };
+
+        char* mBase = nullptr;
+        size_t mCapacity = 0;
+        size_t mUsed = 0;
+        PageKind mPageKind = PageKind::NORMAL;
+        int mNumaNode = -1;
+        uint64_t mHeapFallbacks = 0;
+        std::array<FreeBlock*, kClasses> mFreeLists{};
+
+        static size_t classOf(size_t bytes);
+        bool owns(const void* ptr) const;
+    };
+
+    /**
+     * @class ArenaAllocator
+     * @brief Standard allocator over an Arena, for the map/vector/deque containers of the book.
+     * @details A null arena means the global heap, so containers keep working without an arena.
+     */
+    template<typename T> class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+        explicit ArenaAllocator(Arena* arena) noexcept : mArena(arena) {}
+        template<typename U> ArenaAllocator(const ArenaAllocator<U>& other) noexcept : mArena(other.GetArena()) {}
+
+        T* allocate(size_t n)
+        {
+            if (!mArena) {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T*>(mArena->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept
+        {
+            if (!mArena) {
+                ::operator delete(ptr);
+                return;
+            }
+            mArena->Deallocate(ptr, n * sizeof(T));
+        }
+
+        Arena* GetArena() const noexcept { return mArena; }
+
+        template<typename U> bool operator==(const ArenaAllocator<U>& other) const noexcept { return mArena == other.GetArena(); }
+        template<typename U> bool operator!=(const ArenaAllocator<U>& other) const noexcept { return mArena != other.GetArena(); }
+
+    private:
+        Arena* mArena = nullptr;
+    };
+} // namespace OrderEngine
+
+#endif //ARENA_H
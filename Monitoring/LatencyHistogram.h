@@ -0,0 +1,98 @@
+#pragma once
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OrderEngine {
+    /**
+     * @struct LatencyHistogram
+     * @brief Fixed-size log-linear histogram of nanosecond latencies.
+     *
+     * @details
+     * - Every power of two is split into 4 sub-buckets, so a recorded value is known to within 25%.
+     * - Buckets are relaxed atomics with a single writer: recording is one increment and
+     *   readers in other threads (or other processes, see StatsSegment) never block it.
+     * - Standard layout with no pointers, it can live in shared memory as is.
+     *
+     * Bucket layout:
+     * - Buckets 0..3 hold the values 0..3 exactly
+     * - From there on, bucket (msb - 1) * 4 + sub holds [(4 + sub) << (msb - 2), (5 + sub) << (msb - 2))
+     */
+    struct LatencyHistogram
+    {
+        static constexpr size_t kSubBucketBits = 2;
+        static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+        static constexpr size_t kBuckets = 64 * kSubBuckets - kSubBuckets;
+
+        std::atomic<uint64_t> mBuckets[kBuckets]{};
+
+        static size_t BucketOf(uint64_t value)
+        {
+            if (value < kSubBuckets) {
+                return static_cast<size_t>(value);
+            }
+            size_t msb = 63 - static_cast<size_t>(__builtin_clzll(value));
+            size_t sub = static_cast<size_t>(value >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+            return (msb - 1) * kSubBuckets + sub;
+        }
+
+        // Smallest value that falls into bucket
+        static uint64_t LowerBound(size_t bucket)
+        {
+            if (bucket < kSubBuckets) {
+                return bucket;
+            }
+            size_t msb = bucket / kSubBuckets + 1;
+            uint64_t sub = bucket % kSubBuckets;
+            return (kSubBuckets + sub) << (msb - kSubBucketBits);
+        }
+
+        void Record(uint64_t nanos)
+        {
+            auto& bucket = mBuckets[BucketOf(nanos)];
+            // Single writer: a load/store pair is enough and avoids a locked instruction
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void Reset()
+        {
+            for (auto& bucket : mBuckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        uint64_t Count() const
+        {
+            uint64_t total = 0;
+            for (const auto& bucket : mBuckets) {
+                total += bucket.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Lower bound of the bucket holding the given quantile (0.0 - 1.0), 0 if empty.
+         */
+        uint64_t Percentile(double quantile) const
+        {
+            uint64_t total = Count();
+            if (total == 0) {
+                return 0;
+            }
+            uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; ++i) {
+                seen += mBuckets[i].load(std::memory_order_relaxed);
+                if (seen >= rank) {
+                    return LowerBound(i);
+                }
+            }
+            return LowerBound(kBuckets - 1);
+        }
+    };
+} // namespace OrderEngine
+
+#endif //LATENCY_HISTOGRAM_H
@@ -0,0 +1,139 @@
+/**
+ * @file StatsCli.cpp
+ * @brief Prints the counters of a running engine from its shared memory stats segment.
+ *
+ * Usage:
+ *   MatchingEngine_stats [segment]                 Print the current counters
+ *   MatchingEngine_stats [segment] --diff <secs>   Print per-second rates over an interval
+ *
+ * The segment is attached read-only, nothing here can disturb the engine.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StatsSegment.h"
+
+namespace
+{
+    using namespace OrderEngine;
+
+    constexpr const char* kDefaultSegment = "/matching_engine_stats";
+
+    // Plain copy of a record, so two readings can be compared
+    struct BookReading
+    {
+        std::string mSymbol;
+        uint64_t mCounters[7];
+        uint64_t mGauges[4];
+        uint64_t mLatencyCount;
+        uint64_t mP50, mP99, mP999;
+    };
+
+    const char* kCounterNames[] = {"added", "cancelled", "replaced", "expired", "rejected", "trades", "volume"};
+    const char* kGaugeNames[] = {"pending_trades", "armed_timers", "levels_in_use", "levels_capacity"};
+
+    BookReading read(const BookStatsRecord& record)
+    {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        BookReading reading;
+        reading.mSymbol.assign(record.mSymbol, strnlen(record.mSymbol, BookStatsRecord::kSymbolSize));
+        reading.mCounters[0] = record.mTotalOrdersAdded.load(relaxed);
+        reading.mCounters[1] = record.mTotalOrdersCancelled.load(relaxed);
+        reading.mCounters[2] = record.mTotalOrdersReplaced.load(relaxed);
+        reading.mCounters[3] = record.mTotalOrdersExpired.load(relaxed);
+        reading.mCounters[4] = record.mTotalRejected.load(relaxed);
+        reading.mCounters[5] = record.mTotalTrades.load(relaxed);
+        reading.mCounters[6] = record.mTotalVolume.load(relaxed);
+        reading.mGauges[0] = record.mPendingTrades.load(relaxed);
+        reading.mGauges[1] = record.mArmedExpiryTimers.load(relaxed);
+        reading.mGauges[2] = record.mPriceLevelsInUse.load(relaxed);
+        reading.mGauges[3] = record.mPriceLevelsCapacity.load(relaxed);
+        reading.mLatencyCount = record.mAddOrderLatency.Count();
+        reading.mP50 = record.mAddOrderLatency.Percentile(0.50);
+        reading.mP99 = record.mAddOrderLatency.Percentile(0.99);
+        reading.mP999 = record.mAddOrderLatency.Percentile(0.999);
+        return reading;
+    }
+
+    std::vector<BookReading> readAll(const StatsSegment& segment)
+    {
+        std::vector<BookReading> readings;
+        for (uint32_t i = 0; i < segment.GetBookCount(); ++i) {
+            readings.push_back(read(segment.GetBook(i)));
+        }
+        return readings;
+    }
+
+    void print(const BookReading& book)
+    {
+        std::printf("[%s]\n", book.mSymbol.c_str());
+        for (size_t i = 0; i < 7; ++i) {
+            std::printf("  %-16s %llu\n", kCounterNames[i], static_cast<unsigned long long>(book.mCounters[i]));
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            std::printf("  %-16s %llu\n", kGaugeNames[i], static_cast<unsigned long long>(book.mGauges[i]));
+        }
+        std::printf("  addOrder latency n=%llu p50>=%lluns p99>=%lluns p99.9>=%lluns\n",
+                    static_cast<unsigned long long>(book.mLatencyCount), static_cast<unsigned long long>(book.mP50),
+                    static_cast<unsigned long long>(book.mP99), static_cast<unsigned long long>(book.mP999));
+    }
+
+    void printDiff(const BookReading& before, const BookReading& after, double seconds)
+    {
+        std::printf("[%s] over %.1fs\n", after.mSymbol.c_str(), seconds);
+        for (size_t i = 0; i < 7; ++i) {
+            uint64_t delta = after.mCounters[i] - before.mCounters[i];
+            std::printf("  %-16s +%llu (%.0f/s)\n", kCounterNames[i], static_cast<unsigned long long>(delta), delta / seconds);
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            std::printf("  %-16s %llu -> %llu\n", kGaugeNames[i], static_cast<unsigned long long>(before.mGauges[i]),
+                        static_cast<unsigned long long>(after.mGauges[i]));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string name = kDefaultSegment;
+    double diffSeconds = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--diff") == 0 && i + 1 < argc) {
+            diffSeconds = std::atof(argv[++i]);
+        }
+        else {
+            name = argv[i];
+        }
+    }
+
+    try {
+        StatsSegment segment = StatsSegment::OpenReadOnly(name);
+        std::printf("segment %s, writer pid %llu, %u books\n", name.c_str(),
+                    static_cast<unsigned long long>(segment.GetHeader().mWriterPid), segment.GetBookCount());
+
+        auto before = readAll(segment);
+        if (diffSeconds <= 0) {
+            for (const auto& book : before) {
+                print(book);
+            }
+            return 0;
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(diffSeconds));
+        auto after = readAll(segment);
+        for (size_t i = 0; i < before.size() && i < after.size(); ++i) {
+            printDiff(before[i], after[i], diffSeconds);
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,161 @@
+#include "StatsSegment.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OrderEngine {
+
+    static size_t segmentSize(uint32_t maxBooks)
+    {
+        return sizeof(StatsSegmentHeader) + static_cast<size_t>(maxBooks) * sizeof(BookStatsRecord);
+    }
+
+    static std::runtime_error segmentError(const std::string& what, const std::string& name)
+    {
+        return std::runtime_error("StatsSegment " + name + ": " + what + " (" + std::strerror(errno) + ")");
+    }
+
+    StatsSegment StatsSegment::Create(const std::string& name, uint32_t maxBooks)
+    {
+        shm_unlink(name.c_str()); // Drop a leftover segment of a previous run
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            throw segmentError("shm_open failed", name);
+        }
+
+        size_t size = segmentSize(maxBooks);
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw segmentError("ftruncate failed", name);
+        }
+
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            throw segmentError("mmap failed", name);
+        }
+
+        // Fresh pages are zeroed, which is the initial value of every counter
+        auto* header = new (base) StatsSegmentHeader{};
+        header->mVersion = kStatsSegmentVersion;
+        header->mMaxBooks = maxBooks;
+        header->mBookCount.store(0, std::memory_order_relaxed);
+        header->mWriterPid = static_cast<uint64_t>(getpid());
+        // Magic last: readers that see it see an initialized header
+        std::atomic_thread_fence(std::memory_order_release);
+        header->mMagic = kStatsSegmentMagic;
+
+        return StatsSegment(base, size, name, true);
+    }
+
+    StatsSegment StatsSegment::OpenReadOnly(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw segmentError("shm_open failed", name);
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(StatsSegmentHeader)) {
+            close(fd);
+            throw std::runtime_error("StatsSegment " + name + ": segment too small");
+        }
+
+        size_t size = static_cast<size_t>(st.st_size);
+        void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            throw segmentError("mmap failed", name);
+        }
+
+        StatsSegment segment(base, size, name, false);
+        const StatsSegmentHeader& header = segment.GetHeader();
+        if (header.mMagic != kStatsSegmentMagic || header.mVersion != kStatsSegmentVersion
+            || size < segmentSize(header.mMaxBooks)) {
+            throw std::runtime_error("StatsSegment " + name + ": unknown layout");
+        }
+        return segment;
+    }
+
+    StatsSegment::StatsSegment(void* base, size_t size, std::string name, bool owner)
+        : mBase(base), mSize(size), mName(std::move(name)), mOwner(owner) {}
+
+    StatsSegment::StatsSegment(StatsSegment&& other) noexcept
+        : mBase(std::exchange(other.mBase, nullptr)),
+          mSize(std::exchange(other.mSize, 0)),
+          mName(std::move(other.mName)),
+          mOwner(std::exchange(other.mOwner, false)) {}
+
+    StatsSegment& StatsSegment::operator=(StatsSegment&& other) noexcept
+    {
+        if (this != &other) {
+            this->~StatsSegment();
+            mBase = std::exchange(other.mBase, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+            mName = std::move(other.mName);
+            mOwner = std::exchange(other.mOwner, false);
+        }
+        return *this;
+    }
+
+    StatsSegment::~StatsSegment()
+    {
+        if (mBase) {
+            munmap(mBase, mSize);
+            mBase = nullptr;
+        }
+        if (mOwner) {
+            shm_unlink(mName.c_str());
+            mOwner = false;
+        }
+    }
+
+    BookStatsRecord* StatsSegment::AddBook(const std::string& symbol)
+    {
+        StatsSegmentHeader* hdr = header();
+        uint32_t index = hdr->mBookCount.load(std::memory_order_relaxed);
+        if (index >= hdr->mMaxBooks) {
+            return nullptr;
+        }
+
+        BookStatsRecord* record = &records()[index];
+        std::strncpy(record->mSymbol, symbol.c_str(), BookStatsRecord::kSymbolSize - 1);
+        record->mSymbol[BookStatsRecord::kSymbolSize - 1] = '\0';
+        // Publish the record only after its symbol is in place
+        hdr->mBookCount.store(index + 1, std::memory_order_release);
+        return record;
+    }
+
+    const StatsSegmentHeader& StatsSegment::GetHeader() const
+    {
+        return *header();
+    }
+
+    uint32_t StatsSegment::GetBookCount() const
+    {
+        return header()->mBookCount.load(std::memory_order_acquire);
+    }
+
+    const BookStatsRecord& StatsSegment::GetBook(uint32_t index) const
+    {
+        return records()[index];
+    }
+
+    StatsSegmentHeader* StatsSegment::header() const
+    {
+        return static_cast<StatsSegmentHeader*>(mBase);
+    }
+
+    BookStatsRecord* StatsSegment::records() const
+    {
+        return reinterpret_cast<BookStatsRecord*>(static_cast<char*>(mBase) + sizeof(StatsSegmentHeader));
+    }
+} // namespace OrderEngine
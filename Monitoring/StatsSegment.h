@@ -0,0 +1,113 @@
+#pragma once
+#ifndef STATS_SEGMENT_H
+#define STATS_SEGMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "LatencyHistogram.h"
+
+namespace OrderEngine {
+    /**
+     * @struct BookStatsRecord
+     * @brief Counters of one order book as laid out in the shared memory stats segment.
+     * @details
+     * - Written by the book thread with relaxed stores, read by monitoring processes at any time.
+     * - Field order and sizes are part of the segment format, bump kStatsSegmentVersion when they change.
+     */
+    struct alignas(64) BookStatsRecord
+    {
+        static constexpr size_t kSymbolSize = 16;
+
+        char mSymbol[kSymbolSize];
+
+        // Counters
+        std::atomic<uint64_t> mTotalOrdersAdded;
+        std::atomic<uint64_t> mTotalOrdersCancelled;
+        std::atomic<uint64_t> mTotalOrdersReplaced;
+        std::atomic<uint64_t> mTotalOrdersExpired;
+        std::atomic<uint64_t> mTotalRejected;
+        std::atomic<uint64_t> mTotalTrades;
+        std::atomic<uint64_t> mTotalVolume;
+
+        // Gauges
+        std::atomic<uint64_t> mPendingTrades;       // Queue depth of undrained executions
+        std::atomic<uint64_t> mArmedExpiryTimers;
+        std::atomic<uint64_t> mPriceLevelsInUse;    // Level pool occupancy
+        std::atomic<uint64_t> mPriceLevelsCapacity;
+
+        LatencyHistogram mAddOrderLatency;
+    };
+
+    /**
+     * @struct StatsSegmentHeader
+     * @brief Start of the stats segment, followed by mMaxBooks BookStatsRecord entries.
+     */
+    struct alignas(64) StatsSegmentHeader
+    {
+        uint64_t mMagic;
+        uint32_t mVersion;
+        uint32_t mMaxBooks;
+        std::atomic<uint32_t> mBookCount; // Records [0, mBookCount) are initialized
+        uint32_t mReserved;
+        uint64_t mWriterPid;
+    };
+
+    static constexpr uint64_t kStatsSegmentMagic = 0x53544154534D4531ull; // "STATSME1"
+    static constexpr uint32_t kStatsSegmentVersion = 1;
+
+    /**
+     * @class StatsSegment
+     * @brief Memory-mapped (/dev/shm) segment exposing book counters to other processes.
+     *
+     * @details
+     * - The engine creates the segment and hands one record to each book, the books keep it
+     *   current with relaxed stores, so monitoring adds no locks, syscalls or RPC to the hot path.
+     * - Monitoring tools attach read-only and can read or diff the counters at any rate.
+     * - The layout is fixed and versioned, readers reject segments with another magic or version.
+     */
+    class StatsSegment
+    {
+    public:
+        /**
+         * @brief Creates (or replaces) the named segment with room for maxBooks records.
+         * @throws std::runtime_error if the segment cannot be created or mapped
+         */
+        static StatsSegment Create(const std::string& name, uint32_t maxBooks);
+
+        /**
+         * @brief Attaches to an existing segment read-only.
+         * @throws std::runtime_error if it does not exist or has an unexpected layout
+         */
+        static StatsSegment OpenReadOnly(const std::string& name);
+
+        StatsSegment(StatsSegment&& other) noexcept;
+        StatsSegment& operator=(StatsSegment&& other) noexcept;
+        StatsSegment(const StatsSegment&) = delete;
+        StatsSegment& operator=(const StatsSegment&) = delete;
+        ~StatsSegment();
+
+        /**
+         * @brief Reserves the next record for a book. Writer only.
+         * @return nullptr once all records are taken
+         */
+        BookStatsRecord* AddBook(const std::string& symbol);
+
+        const StatsSegmentHeader& GetHeader() const;
+        uint32_t GetBookCount() const;
+        const BookStatsRecord& GetBook(uint32_t index) const;
+
+    private:
+        StatsSegment(void* base, size_t size, std::string name, bool owner);
+
+        void* mBase = nullptr;
+        size_t mSize = 0;
+        std::string mName;
+        bool mOwner = false; // Creator unlinks the segment on destruction
+
+        StatsSegmentHeader* header() const;
+        BookStatsRecord* records() const;
+    };
+} // namespace OrderEngine
+
+#endif //STATS_SEGMENT_H
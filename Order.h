@@ -35,7 +35,7 @@ namespace OrderEngine
             return mId;
         }
 
-        Base::Symbol GetSymbol() const
+        const Base::Symbol& GetSymbol() const
         {
             return mSymbol;
         }
@@ -85,6 +85,53 @@ namespace OrderEngine
             return mStopPrice;
         }
 
+        Base::OwnerId GetOwner() const
+        {
+            return mOwner;
+        }
+
+        void SetOwner(Base::OwnerId owner)
+        {
+            mOwner = owner;
+        }
+
+        Base::TimeInForce GetTimeInForce() const
+        {
+            return mTimeInForce;
+        }
+
+        void SetTimeInForce(Base::TimeInForce timeInForce)
+        {
+            mTimeInForce = timeInForce;
+        }
+
+        // Wall time the order was constructed, its arrival at the book
+        Base::Timestamp GetCreatedAt() const
+        {
+            return mCreatedAt;
+        }
+
+        // Expiry of GTD/GTT orders
+        Base::Timestamp GetExpireTime() const
+        {
+            return mExpireTime;
+        }
+
+        void SetExpireTime(Base::Timestamp expireTime)
+        {
+            mExpireTime = expireTime;
+        }
+
+        // Expiry timer armed by the book while the order rests, kNoTimer otherwise
+        uint32_t GetExpiryTimer() const { return mExpiryTimer; }
+        void SetExpiryTimer(uint32_t timerId) { mExpiryTimer = timerId; }
+
+        // Intrusive links of the per-owner order list, maintained by OwnerIndex
+        Order* GetPrevByOwner() const { return mPrevByOwner; }
+        Order* GetNextByOwner() const { return mNextByOwner; }
+        void SetPrevByOwner(Order* order) { mPrevByOwner = order; }
+        void SetNextByOwner(Order* order) { mNextByOwner = order; }
+
         void SetType(Base::OrderType orderType)
         {
             mType = orderType;
@@ -95,6 +142,7 @@ namespace OrderEngine
             return mType;
         }
         
+        // Diagnostics only, it allocates; the book calls it from ORDER_ENGINE_TRACE alone
         std::string ToString() const
         {
             std::ostringstream oss;
@@ -133,8 +181,14 @@ namespace OrderEngine
         Base::OrderStatus mStatus;
         Base::Timestamp mCreatedAt;
         Base::Price mStopPrice;
+        Base::OwnerId mOwner{};
+        Order* mPrevByOwner{nullptr};
+        Order* mNextByOwner{nullptr};
+        Base::TimeInForce mTimeInForce{Base::TimeInForce::GTC};
+        Base::Timestamp mExpireTime{};
+        uint32_t mExpiryTimer{UINT32_MAX};
         
-        static std::string OrderSideToString(Base::OrderSide side)
+        static const char* OrderSideToString(Base::OrderSide side)
         {
             switch (side)
             {
@@ -144,7 +198,7 @@ namespace OrderEngine
             }
         }
 
-        static std::string OrderStatusToString(Base::OrderStatus status)
+        static const char* OrderStatusToString(Base::OrderStatus status)
         {
             switch (status)
             {
@@ -155,6 +209,7 @@ namespace OrderEngine
             case Base::OrderStatus::REPLACED: return "REPLACED";
             case Base::OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
             case Base::OrderStatus::CANCELLED: return "CANCELLED";
+            case Base::OrderStatus::EXPIRED: return "EXPIRED";
             default: return "UNKNOWN";
             }
         }
@@ -0,0 +1,103 @@
+#include "AuctionCalculator.h"
+
+#include <algorithm>
+
+namespace OrderEngine {
+
+    AuctionResult AuctionCalculator::Compute(const std::vector<Base::LevelInfo>& bids,
+                                             const std::vector<Base::LevelInfo>& asks,
+                                             Base::Price referencePrice)
+    {
+        AuctionResult result;
+        if (bids.empty() || asks.empty()) {
+            return result;
+        }
+
+        // ==== Merge both sides into one ascending, dense price array ====
+        mPrices.clear();
+        mBidQty.clear();
+        mAskQty.clear();
+
+        // Bids arrive highest first, walk them backwards to get ascending prices
+        auto bidIt = bids.rbegin();
+        auto askIt = asks.begin();
+        while (bidIt != bids.rend() || askIt != asks.end()) {
+            Base::Price price;
+            Base::Quantity bidQty = 0;
+            Base::Quantity askQty = 0;
+
+            if (askIt == asks.end() || (bidIt != bids.rend() && bidIt->mPrice < askIt->mPrice)) {
+                price = bidIt->mPrice;
+                bidQty = (bidIt++)->mQuantity;
+            }
+            else if (bidIt == bids.rend() || askIt->mPrice < bidIt->mPrice) {
+                price = askIt->mPrice;
+                askQty = (askIt++)->mQuantity;
+            }
+            else { // Both sides have a level at this price
+                price = askIt->mPrice;
+                bidQty = (bidIt++)->mQuantity;
+                askQty = (askIt++)->mQuantity;
+            }
+
+            mPrices.push_back(price);
+            mBidQty.push_back(bidQty);
+            mAskQty.push_back(askQty);
+        }
+
+        const size_t n = mPrices.size();
+        mDemand.resize(n);
+        mSupply.resize(n);
+
+        // ==== Cumulative quantities ====
+        // Supply at a price: every ask at that price or lower
+        Base::Quantity supply = 0;
+        for (size_t i = 0; i < n; ++i) {
+            supply += mAskQty[i];
+            mSupply[i] = supply;
+        }
+
+        // Demand at a price: every bid at that price or higher
+        Base::Quantity demand = 0;
+        for (size_t i = n; i-- > 0;) {
+            demand += mBidQty[i];
+            mDemand[i] = demand;
+        }
+
+        // ==== Pick the equilibrium price ====
+        size_t best = n;
+        Base::Quantity bestVolume = 0;
+        Base::Quantity bestImbalance = 0;
+        Base::Price bestDistance = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            Base::Quantity volume = std::min(mDemand[i], mSupply[i]);
+            Base::Quantity imbalance = std::max(mDemand[i], mSupply[i]) - volume;
+            Base::Price distance = mPrices[i] > referencePrice ? mPrices[i] - referencePrice : referencePrice - mPrices[i];
+
+            // Prices are ascending, so on a full tie the earlier (lower) price is kept
+            bool better = best == n
+                || volume > bestVolume
+                || (volume == bestVolume && imbalance < bestImbalance)
+                || (volume == bestVolume && imbalance == bestImbalance && distance < bestDistance);
+
+            if (better) {
+                best = i;
+                bestVolume = volume;
+                bestImbalance = imbalance;
+                bestDistance = distance;
+            }
+        }
+
+        if (bestVolume == 0) {
+            return result;
+        }
+
+        result.mPrice = mPrices[best];
+        result.mVolume = bestVolume;
+        result.mImbalance = bestImbalance;
+        result.mSurplusSide = mDemand[best] >= mSupply[best] ? Base::OrderSide::BUY : Base::OrderSide::SELL;
+        result.mCrossed = true;
+        return result;
+    }
+} // namespace OrderEngine
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef AUCTION_CALCULATOR_H
+#define AUCTION_CALCULATOR_H
+
+#include <vector>
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @struct AuctionResult
+     * @brief Outcome of an auction uncross.
+     * @details
+     * - mPrice     : Equilibrium price, every crossing fill executes at this price.
+     * - mVolume    : Executable quantity at mPrice (matched on both sides).
+     * - mImbalance : Unmatched quantity left on the surplus side at mPrice.
+     * - mCrossed   : False if the book was not crossed, nothing trades in that case.
+     */
+    struct AuctionResult
+    {
+        Base::Price mPrice{};
+        Base::Quantity mVolume{};
+        Base::Quantity mImbalance{};
+        Base::OrderSide mSurplusSide{Base::OrderSide::BUY};
+        bool mCrossed{false};
+    };
+
+    /**
+     * @class AuctionCalculator
+     * @brief Finds the equilibrium price of a call auction.
+     * @details
+     * Candidate prices are the prices of all crossing levels. For each of them we need
+     * - demand: total bid quantity willing to buy at that price or higher
+     * - supply: total ask quantity willing to sell at that price or lower
+     * The levels of both sides are merged once into dense arrays, after which demand and
+     * supply are plain suffix/prefix sums and the selection is a single linear scan.
+     * The price chosen:
+     * 1. Maximizes executable volume min(demand, supply)
+     * 2. Then minimizes the imbalance |demand - supply|
+     * 3. Then is closest to the reference price
+     * 4. Then is the lower price, so the result is deterministic
+     *
+     * Scratch arrays are kept between calls so repeated uncrosses do not allocate.
+     */
+    class AuctionCalculator
+    {
+    public:
+        /**
+         * @param bids Crossing bid levels, best (highest) price first
+         * @param asks Crossing ask levels, best (lowest) price first
+         * @param referencePrice Tie-break price, usually the previous close or last trade
+         */
+        AuctionResult Compute(const std::vector<Base::LevelInfo>& bids,
+                              const std::vector<Base::LevelInfo>& asks,
+                              Base::Price referencePrice);
+
+    private:
+        std::vector<Base::Price> mPrices;       // Candidate prices, ascending
+        std::vector<Base::Quantity> mBidQty;    // Bid quantity resting exactly at mPrices[i]
+        std::vector<Base::Quantity> mAskQty;    // Ask quantity resting exactly at mPrices[i]
+        std::vector<Base::Quantity> mDemand;    // Cumulative bid quantity at mPrices[i] or higher
+        std::vector<Base::Quantity> mSupply;    // Cumulative ask quantity at mPrices[i] or lower
+    };
+} // namespace OrderEngine
+
+#endif //AUCTION_CALCULATOR_H
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef CONCURRENCY_POLICY_H
+#define CONCURRENCY_POLICY_H
+
+#include <atomic>
+#include <mutex>
+
+namespace OrderEngine {
+    /**
+     * Concurrency policies of OrderBook and OrderBookStats, chosen per book at compile time.
+     * - A policy provides the book lock and the wrapper of its counters and market state:
+     *       using Mutex = ...;                       // taken recursively by every public operation
+     *       template<typename T> using Atomic = ...; // load/store/++/+= and assignment
+     * - ThreadSafePolicy is the shared book: any thread may call into it and read its stats.
+     * - SingleThreadedPolicy is for a book only its owning thread touches (a shard worker, replay,
+     *   backtests). The lock compiles away and the counters are plain integers: no locked
+     *   instructions, no fences, nothing stopping the compiler from keeping them in registers.
+     * - The depth snapshot is published lock-free under both, its readers may be other threads.
+     */
+
+    /**
+     * @class NullMutex
+     * @brief Lockable that does nothing.
+     */
+    struct NullMutex
+    {
+        void lock() noexcept {}
+        bool try_lock() noexcept { return true; }
+        void unlock() noexcept {}
+    };
+
+    /**
+     * @class PlainAtomic
+     * @tparam T Value type
+     * @brief Plain value behind the part of the std::atomic interface the book uses.
+     * @details Memory orders are accepted and ignored. Not safe to share between threads.
+     */
+    template<typename T> class PlainAtomic
+    {
+    public:
+        constexpr PlainAtomic() noexcept = default;
+        constexpr PlainAtomic(T value) noexcept : mValue(value) {}
+        PlainAtomic(const PlainAtomic&) = delete;
+        PlainAtomic& operator=(const PlainAtomic&) = delete;
+
+        T load(std::memory_order = std::memory_order_seq_cst) const noexcept { return mValue; }
+        void store(T value, std::memory_order = std::memory_order_seq_cst) noexcept { mValue = value; }
+        operator T() const noexcept { return mValue; }
+
+        T operator=(T value) noexcept { return mValue = value; }
+        T operator++() noexcept { return ++mValue; }
+        T operator++(int) noexcept { return mValue++; }
+        T operator+=(T delta) noexcept { return mValue += delta; }
+
+    private:
+        T mValue{};
+    };
+
+    struct ThreadSafePolicy
+    {
+        using Mutex = std::recursive_mutex;
+        template<typename T> using Atomic = std::atomic<T>;
+    };
+
+    struct SingleThreadedPolicy
+    {
+        using Mutex = NullMutex;
+        template<typename T> using Atomic = PlainAtomic<T>;
+    };
+} // namespace OrderEngine
+
+#endif //CONCURRENCY_POLICY_H
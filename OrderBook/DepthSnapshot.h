@@ -0,0 +1,68 @@
+#pragma once
+#ifndef DEPTH_SNAPSHOT_H
+#define DEPTH_SNAPSHOT_H
+
+#include <array>
+#include "../OrderTypes.h"
+#include "../Analytics/TradeAggregator.h"
+
+namespace OrderEngine {
+    /**
+     * @struct DepthSnapshot
+     * @brief Immutable, versioned view of the top of an order book.
+     * @details
+     * - Published by the book after every change, read lock-free through OrderBook::getDepthSnapshot().
+     * - mVersion increases by one per publication, readers can use it to skip unchanged books.
+     * - Only the first mBidLevels/mAskLevels entries of mBids/mAsks are valid, best price first.
+     * - Imbalance and microprice come from quantities the book keeps incrementally over its best
+     *   mImbalanceLevels levels (see OrderBookConfig), which may go deeper than kDepth.
+     */
+    struct DepthSnapshot
+    {
+        static constexpr size_t kDepth = 10;
+
+        uint64_t mVersion{};
+        std::array<Base::LevelInfo, kDepth> mBids{};
+        std::array<Base::LevelInfo, kDepth> mAsks{};
+        uint32_t mBidLevels{};
+        uint32_t mAskLevels{};
+
+        // Top-N analytics
+        uint32_t mImbalanceLevels{};
+        Base::Quantity mTopBidQuantity{};   // Open quantity of the best mImbalanceLevels bid levels
+        Base::Quantity mTopAskQuantity{};
+        double mImbalance{};                // (bid - ask) / (bid + ask) of those quantities, 0 if both are empty
+        double mMicroprice{};               // Best bid and ask weighted by the opposite side's quantity, 0 unless both quote
+
+        // Market state
+        Base::TradingPhase mPhase{Base::TradingPhase::CONTINUOUS};
+        Base::Price mLastTradePrice{};
+        Base::Quantity mLastTradeQty{};
+
+        // Statistics
+        uint64_t mTotalOrdersAdded{};
+        uint64_t mTotalOrdersCancelled{};
+        uint64_t mTotalOrdersExpired{};
+        uint64_t mTotalRejected{};
+        uint64_t mTotalTrades{};
+        uint64_t mTotalVolume{};
+        uint64_t mPriceLevelsInUse{};
+
+        // Session and interval OHLCV/VWAP bars
+        TradeStatistics mTradeStatistics{};
+    };
+
+    /**
+     * @class DepthListener
+     * @brief Receives every depth snapshot a book publishes, on the book's thread.
+     * @details Runs inside the book operation, implementations must be bounded and never block.
+     */
+    class DepthListener
+    {
+    public:
+        virtual ~DepthListener() = default;
+        virtual void onDepthUpdate(const DepthSnapshot& snapshot) = 0;
+    };
+} // namespace OrderEngine
+
+#endif //DEPTH_SNAPSHOT_H
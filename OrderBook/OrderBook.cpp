@@ -7,57 +7,308 @@
 #include <utility>
 
 namespace OrderEngine {
-    template <typename OrderPtr>
-    OrderBook<OrderPtr>::OrderBook(Base::Symbol  symbol):
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::OrderBook(Base::Symbol  symbol, size_t reservedLevels, Arena* arena):
+        OrderBook(std::move(symbol), OrderBookConfig{reservedLevels}, arena) {}
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::OrderBook(Base::Symbol symbol, const OrderBookConfig& config, Arena* arena):
         mSymbol(std::move(symbol)),
-        mBidTracker(true),
-        mAskTracker(false),
-        mStopBidTracker(true),
-        mStopAskTracker(false),
+        mLevelPool(config.mReservedLevels, arena, config.mOrdersPerLevel),
+        mBidTracker(mLevelPool, config.mReservedOrders),
+        mAskTracker(mLevelPool, config.mReservedOrders),
+        mStopBidTracker(mLevelPool),
+        mStopAskTracker(mLevelPool),
         mMarketPrice(0),
         mLastTradePrice(0),
-        mLastTradeQty(0){
-            mPendingTrades.reserve(1000);
+        mLastTradeQty(0),
+        mPendingTrades(ArenaAllocator<TradeExecution>(arena)),
+        mOwnerIndex(arena),
+        mExpiryWheel(TimerWheel::kNotStarted, arena){
+            mPendingTrades.reserve(config.mReservedTrades);
+            mSweptOrders.reserve(config.mReservedFills);
+            mCancelledOrders.reserve(config.mReservedFills);
+            mMatches.reserve(config.mReservedFills);
+            // A level taken whole fills every order in it, the policy scratch is bounded the same way
+            mMatchingPolicy.Reserve(config.mReservedFills);
+            // Every resting order of both sides may carry an expiry timer, and one sweep may expire them all
+            mExpiryWheel.Reserve(2 * config.mReservedOrders);
+            mExpiredOrderIds.reserve(2 * config.mReservedOrders);
+            mBidTracker.SetTopDepth(config.mImbalanceLevels);
+            mAskTracker.SetTopDepth(config.mImbalanceLevels);
+            // Stop triggers are not depth, their trackers keep no top sums
+            mStopBidTracker.SetTopDepth(0);
+            mStopAskTracker.SetTopDepth(0);
+            onBookUpdated();
         }
 
-    template <typename OrderPtr>
-    void OrderBook<OrderPtr>::setMarketPrice(Base::Price price)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setMarketPrice(Base::Price price)
     {
         mMarketPrice.store(price);
     }
 
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    const typename OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::Stats&
+    OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getStats() const
+    {
+        return mStats;
+    }
+
+    /**
+     * @method onBookUpdated
+     * @details Called at the end of every operation that can change the book: refreshes
+     *          the gauges and publishes a new depth snapshot.
+     */
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::onBookUpdated()
+    {
+        mStats.mPriceLevelsInUse.store(mLevelPool.GetLevelsInUse(), std::memory_order_relaxed);
+        mStats.mPriceLevelsCapacity.store(mLevelPool.GetCapacity(), std::memory_order_relaxed);
+        if (mPublishSnapshots) {
+            publishSnapshot();
+        }
+        if (mStatsRecord) {
+            writeStatsRecord();
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::writeStatsRecord()
+    {
+        constexpr auto relaxed = std::memory_order_relaxed;
+        mStatsRecord->mTotalOrdersAdded.store(mStats.mTotalOrdersAdded.load(relaxed), relaxed);
+        mStatsRecord->mTotalOrdersCancelled.store(mStats.mTotalOrdersCancelled.load(relaxed), relaxed);
+        mStatsRecord->mTotalOrdersReplaced.store(mStats.mTotalOrdersReplaced.load(relaxed), relaxed);
+        mStatsRecord->mTotalOrdersExpired.store(mStats.mTotalOrdersExpired.load(relaxed), relaxed);
+        mStatsRecord->mTotalRejected.store(mStats.mTotalRejected.load(relaxed), relaxed);
+        mStatsRecord->mTotalTrades.store(mStats.mTotalTrades.load(relaxed), relaxed);
+        mStatsRecord->mTotalVolume.store(mStats.mTotalVolume.load(relaxed), relaxed);
+        mStatsRecord->mPendingTrades.store(mPendingTrades.size(), relaxed);
+        mStatsRecord->mArmedExpiryTimers.store(mExpiryWheel.GetArmedCount(), relaxed);
+        mStatsRecord->mPriceLevelsInUse.store(mStats.mPriceLevelsInUse.load(relaxed), relaxed);
+        mStatsRecord->mPriceLevelsCapacity.store(mStats.mPriceLevelsCapacity.load(relaxed), relaxed);
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::attachStatsRecord(BookStatsRecord* record)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mStatsRecord = record;
+        mLatencySink = record ? &record->mAddOrderLatency : &mAddOrderLatency;
+        if (mStatsRecord) {
+            writeStatsRecord();
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    const LatencyHistogram& OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getAddOrderLatency() const
+    {
+        return *mLatencySink;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::publishSnapshot()
+    {
+        // Bounded cost: kDepth levels per side plus a handful of counters
+        DepthSnapshot& snapshot = mSnapshots.BeginWrite();
+        snapshot.mVersion = ++mSnapshotVersion;
+        snapshot.mBidLevels = static_cast<uint32_t>(mBidTracker.GetTopLevels(snapshot.mBids.data(), DepthSnapshot::kDepth));
+        snapshot.mAskLevels = static_cast<uint32_t>(mAskTracker.GetTopLevels(snapshot.mAsks.data(), DepthSnapshot::kDepth));
+
+        Base::Quantity bidQty = mBidTracker.GetTopQuantity();
+        Base::Quantity askQty = mAskTracker.GetTopQuantity();
+        double totalQty = static_cast<double>(bidQty) + static_cast<double>(askQty);
+        snapshot.mImbalanceLevels = static_cast<uint32_t>(mBidTracker.GetTopDepth());
+        snapshot.mTopBidQuantity = bidQty;
+        snapshot.mTopAskQuantity = askQty;
+        snapshot.mImbalance = totalQty > 0 ? (static_cast<double>(bidQty) - static_cast<double>(askQty)) / totalQty : 0.0;
+        // Heavier bids pull the fair price towards the ask, and the other way round
+        snapshot.mMicroprice = bidQty && askQty
+            ? (static_cast<double>(mAskTracker.GetBestPrice()) * static_cast<double>(bidQty)
+               + static_cast<double>(mBidTracker.GetBestPrice()) * static_cast<double>(askQty)) / totalQty
+            : 0.0;
+
+        snapshot.mPhase = mPhase.load(std::memory_order_relaxed);
+        snapshot.mLastTradePrice = mLastTradePrice.load(std::memory_order_relaxed);
+        snapshot.mLastTradeQty = mLastTradeQty.load(std::memory_order_relaxed);
+
+        snapshot.mTotalOrdersAdded = mStats.mTotalOrdersAdded.load(std::memory_order_relaxed);
+        snapshot.mTotalOrdersCancelled = mStats.mTotalOrdersCancelled.load(std::memory_order_relaxed);
+        snapshot.mTotalOrdersExpired = mStats.mTotalOrdersExpired.load(std::memory_order_relaxed);
+        snapshot.mTotalRejected = mStats.mTotalRejected.load(std::memory_order_relaxed);
+        snapshot.mTotalTrades = mStats.mTotalTrades.load(std::memory_order_relaxed);
+        snapshot.mTotalVolume = mStats.mTotalVolume.load(std::memory_order_relaxed);
+        snapshot.mPriceLevelsInUse = mStats.mPriceLevelsInUse.load(std::memory_order_relaxed);
+        snapshot.mTradeStatistics = mTradeAggregator.GetStatistics();
+        mSnapshots.EndWrite();
+        // The buffer stays untouched until the next BeginWrite
+        if (mDepthListener) {
+            mDepthListener->onDepthUpdate(snapshot);
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getDepthSnapshot(DepthSnapshot& snapshot) const
+    {
+        mSnapshots.Read(snapshot);
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setSnapshotPublishing(bool enabled)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mPublishSnapshots = enabled;
+        if (enabled) {
+            publishSnapshot();
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setDepthListener(DepthListener* listener)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mDepthListener = listener;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setImbalanceLevels(size_t levels)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mBidTracker.SetTopDepth(levels);
+        mAskTracker.SetTopDepth(levels);
+        onBookUpdated();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getLevels(Base::OrderSide side, std::vector<Base::LevelInfo>& levels) const
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        // The least aggressive limit of the opposite side crosses every level
+        if (side == Base::OrderSide::BUY) {
+            mBidTracker.GetLevels(std::numeric_limits<Base::Price>::min(), levels);
+        }
+        else {
+            mAskTracker.GetLevels(std::numeric_limits<Base::Price>::max(), levels);
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    uint64_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getChecksum() const
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        // Side hashes are sums of level hashes, salting them keeps a bid and an ask with equal fields apart
+        uint64_t bidHash = mBidTracker.GetHash();
+        uint64_t askHash = mAskTracker.GetHash();
+        return (bidHash ^ (bidHash >> 29)) * 0x9e3779b97f4a7c15ull + (askHash ^ (askHash >> 31)) * 0xc2b2ae3d27d4eb4full;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    uint64_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getLevelChecksum(Base::OrderSide side, Base::Price price) const
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        return side == Base::OrderSide::BUY ? mBidTracker.GetLevelHash(price) : mAskTracker.GetLevelHash(price);
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::queuePosition(Base::OrderId orderId, Base::QueuePosition& position) const
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        return mBidTracker.GetQueuePosition(orderId, position) || mAskTracker.GetQueuePosition(orderId, position);
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::holdsOrder(const OrderPtr& order) const
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        Base::OrderId orderId = order->GetId();
+        if (order->GetSide() == Base::OrderSide::BUY) {
+            return mBidTracker.FindOrder(orderId) == order || mStopBidTracker.FindOrder(orderId) == order;
+        }
+        return mAskTracker.FindOrder(orderId) == order || mStopAskTracker.FindOrder(orderId) == order;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setBarIntervals(const std::vector<std::chrono::nanoseconds>& intervals)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mTradeAggregator.SetIntervals(intervals.data(), intervals.size());
+        onBookUpdated();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::drainTrades(std::vector<TradeExecution>& trades)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        size_t drained = mPendingTrades.size();
+        trades.insert(trades.end(), mPendingTrades.begin(), mPendingTrades.end());
+        mPendingTrades.clear();
+        return drained;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::setSessionClose(Base::Timestamp sessionClose)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mSessionClose = sessionClose;
+    }
+
     // <===================================== addOrder Mathod =====================================>
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::addOrder(const OrderPtr& order, Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::addOrder(const OrderPtr& order, Base::OrderConditions conditions)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::lock_guard<Mutex> lock(mBookMutex); // acquire lock
+        bool filled = processOrder(order, conditions);
+        // Recorded under the lock, the histogram has a single writer even when threads share the book
+        mLatencySink->Record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        return filled;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::processOrder(const OrderPtr& order, Base::OrderConditions conditions)
     {
         // Order* order = new Order();
-        std::lock_guard<std::recursive_mutex> lock(mBookMutex); // acquire lock
-        
         // todo: change design pattern to chain of responsibility
         if (!validateOrder(order)) {
             rejectOrder(order, "Invalid order parameters");
             return false;
         }
+        // Cancels, expiry and owner lists go by id, a second live order with it must not trade or rest
+        if (mBidTracker.FindOrder(order->GetId()) || mAskTracker.FindOrder(order->GetId())) {
+            rejectOrder(order, "Duplicate order id");
+            return false;
+        }
 
         bool filled = false;
 
-        if(order->isMarket()){
+        if(mPhase.load() == Base::TradingPhase::AUCTION){
+            // Call phase: only plain limit orders are collected, nothing matches until the uncross
+            if(!order->isLimit() || isImmediateOrCancel(conditions)) {
+                rejectOrder(order, "Order type not accepted during auction");
+                return false;
+            }
+            addRestingOrder(order);
+        }
+        else if(order->isMarket()){
             filled = processMarketOrder(order, conditions);
-            std::cout<<"Order: "<<order->ToString()<<std::endl;
-            std::cout<<"Filled Flag: "<<filled<<std::endl;
+            ORDER_ENGINE_TRACE("Order: "<<order->ToString());
+            ORDER_ENGINE_TRACE("Filled Flag: "<<filled);
         }
         else if(order->isLimit()){
             filled = processLimitOrder(order, conditions);
-            std::cout<<"[addOrder() method of OrderBook class]: This is a limit orer"<<std::endl;
+            ORDER_ENGINE_TRACE("[addOrder() method of OrderBook class]: This is a limit orer");
         }
         // todo: add order processing for stop order and limit order
         // todo: add notification that order is accepted
         // todo: update market data and depth
+        onBookUpdated();
         return filled;
     }
 
-    template <typename OrderPtr>
-    void OrderBook<OrderPtr>::rejectOrder(const OrderPtr& order, const std::string& reason)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::rejectOrder(const OrderPtr& order, const char* reason)
     {
         order->SetOrderStatus(Base::OrderStatus::REJECTED);
         ++mStats.mTotalRejected;
@@ -67,8 +318,8 @@ namespace OrderEngine {
         //todo: add warn log
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::validateOrder(const OrderPtr& order) const
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::validateOrder(const OrderPtr& order) const
     {
         if(!order) return false;
         if(order->GetSymbol() != mSymbol) return false;
@@ -76,23 +327,17 @@ namespace OrderEngine {
         if(order->GetOpenQuantity() > order->GetQuantity()) return false;
         if(!order->isMarket() && order->GetPrice() <= 0) return false;
         if(order->isStop() && order->GetStopPrice() <= 0) return false;
+        if((order->GetTimeInForce() == Base::TimeInForce::GTD || order->GetTimeInForce() == Base::TimeInForce::GTT)
+            && order->GetExpireTime() == Base::Timestamp{}) return false;
         return true;
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::processMarketOrder(const OrderPtr& inBoundOrderPtr, const Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::processMarketOrder(const OrderPtr& inBoundOrderPtr, const Base::OrderConditions conditions)
     {
-        bool filled = false;
-        if(inBoundOrderPtr->isBuy()){
-            filled = matchMarketBuyOrder(inBoundOrderPtr, conditions);
-        }
-        else {
-            std::cout<<"<========================== Custom =============================>"<<std::endl;
-            std::cout<<"processMarketOrder:matchMarketSellOrder: "<<inBoundOrderPtr->ToString()<<std::endl;
-            std::cout<<"<========================== Custom =============================>"<<std::endl;
-            filled = matchMarketSellOrder(inBoundOrderPtr, conditions);
-            // todo: implement matchMarketSellOrder
-        }
+        bool filled = inBoundOrderPtr->isBuy()
+            ? matchMarketOrder<Base::OrderSide::BUY>(inBoundOrderPtr, conditions)
+            : matchMarketOrder<Base::OrderSide::SELL>(inBoundOrderPtr, conditions);
 
         if (inBoundOrderPtr->GetOpenQuantity() > 0) {
             inBoundOrderPtr->SetOrderStatus(Base::OrderStatus::CANCELLED);
@@ -101,44 +346,74 @@ namespace OrderEngine {
         return filled;
     }
 
-    template <typename OrderPtr>
-    void OrderBook<OrderPtr>::addRestingOrder(const OrderPtr& order)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    template <Base::OrderSide Side>
+    auto& OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::trackerFor()
     {
-        // Order* order = new Order();
-        if(order->isBuy())
-        {
-            mBidTracker.AddOrder(order);
-            order->SetOrderStatus(Base::OrderStatus::PENDING);
-            mStats.mTotalOrdersAdded++;
+        if constexpr (Side == Base::OrderSide::BUY) {
+            return mBidTracker;
         }
-        else // Sell Order
-        {
-            mAskTracker.AddOrder(order);
-            order->SetOrderStatus(Base::OrderStatus::PENDING);
-            mStats.mTotalOrdersAdded++;
+        else {
+            return mAskTracker;
         }
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::matchMarketBuyOrder(const OrderPtr& order, Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::addRestingOrder(const OrderPtr& order)
     {
-        // Order* order = new Order();
-        Base::Price limitPrice = std::numeric_limits<Base::Price>::max(); // No price limit for market orders
-        return matchBuyOrder(order,conditions,limitPrice);
+        bool added = order->isBuy() ? mBidTracker.AddOrder(order) : mAskTracker.AddOrder(order);
+        if (!added) {
+            // Not in the book, so nothing may point at it: no owner link, no expiry timer
+            rejectOrder(order, "Duplicate order id");
+            return;
+        }
+        mOwnerIndex.Link(order);
+        armExpiry(order);
+        order->SetOrderStatus(Base::OrderStatus::PENDING);
+        mStats.mTotalOrdersAdded++;
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::matchBuyOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    template <Base::OrderSide Side>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::matchMarketOrder(const OrderPtr& order, Base::OrderConditions conditions)
     {
+        // No price limit for market orders: take the most aggressive limit for the inbound side
+        constexpr Base::Price limitPrice = Side == Base::OrderSide::BUY
+            ? std::numeric_limits<Base::Price>::max()
+            : std::numeric_limits<Base::Price>::min();
+        return matchOrder<Side>(order, conditions, limitPrice);
+    }
+
+    /**
+     * @method matchOrder
+     * @tparam Side Side of the inbound order, it is matched against the resting orders of the opposite side
+     * @details
+     * - One instantiation per side, the tracker to match against and its price-crossing
+     *   predicate are resolved at compile time.
+     * - Levels the inbound order covers entirely are swept whole first (see sweepLevels),
+     *   only the last, partially taken level goes through the allocation policy.
+     */
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    template <Base::OrderSide Side>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::matchOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice)
+    {
+        constexpr Base::OrderSide restingSide = Base::Opposite(Side);
+
+        // All-or-none is checked per resting order below, it cannot take the sweep path
+        Base::Quantity swept = IsAllOrNone(conditions) ? 0 : sweepLevels<restingSide>(inBoundOrderPtr, limitPrice);
+
         Base::Quantity inBoundOrderRemaining = inBoundOrderPtr->GetOpenQuantity();
-        bool anyFill = false;
+        bool anyFill = swept > 0;
+        if (inBoundOrderRemaining == 0) {
+            return anyFill;
+        }
 
-        // Get matching sell(ask) orders from the ask-order tracker, format: std::vector<std::pair<OrderPtr, Quantity>>
-        // These are order lying in sell section of order booking waiting to be matched with buy orders
-        // These are resting order (orders lying in order book to be matched)
-        auto matches = mAskTracker.MatchQuantity(limitPrice, inBoundOrderRemaining);
+        // Get matching orders from the opposite tracker, format: std::vector<std::pair<OrderPtr, Quantity>>
+        // These are resting orders (orders lying in order book waiting to be matched)
+        mMatches.clear();
+        trackerFor<restingSide>().MatchQuantity(limitPrice, inBoundOrderRemaining, mMatchingPolicy, mMatches);
 
-        for (const auto& [restingOrderPtr, restingOrderRemainingQty] : matches) {
+        for (const auto& [restingOrderPtr, restingOrderRemainingQty] : mMatches) {
 
             if (inBoundOrderRemaining == 0){
                 break;
@@ -153,7 +428,7 @@ namespace OrderEngine {
             Base::Price fillPrice = restingOrderPtr->GetPrice();
 
             // Execute the trade
-            executeTrade(inBoundOrderPtr, restingOrderPtr, fillQty, fillPrice);
+            executeTrade<restingSide>(inBoundOrderPtr, restingOrderPtr, fillQty, fillPrice);
 
             inBoundOrderRemaining -= fillQty;
             anyFill = true;
@@ -171,61 +446,66 @@ namespace OrderEngine {
         return anyFill;
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::matchMarketSellOrder(const OrderPtr& order, Base::OrderConditions conditions)
-    {
-        // Order* order = new Order();
-        Base::Price limitPrice = 0; // No price limit for market orders
-        return matchSellOrder(order,conditions,limitPrice);
-    }
-
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::matchSellOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice)
+    /**
+     * @method sweepLevels
+     * @details
+     * - Consumes, best first, every level whose whole quantity the inbound order can take.
+     * - Each level leaves the tracker in one step, then every resting order gets its own fill
+     *   in time priority, exactly as if it had been matched one by one.
+     * - Fills of a level share one timestamp, statistics and last trade are updated once per level.
+     * @return Quantity taken from the swept levels
+     */
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    template <Base::OrderSide RestingSide>
+    Base::Quantity OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::sweepLevels(const OrderPtr& inBoundOrderPtr, Base::Price limitPrice)
     {
-        // Order* inBoundOrderPtr = new Order();
+        auto& tracker = trackerFor<RestingSide>();
         Base::Quantity inBoundOrderRemaining = inBoundOrderPtr->GetOpenQuantity();
-        bool anyFill = false;
-
-        // Get matching sell(ask) orders from the ask-order tracker, format: format: std::vector<std::pair<OrderPtr, Quantity>>
-        // Thses orders are lying in the buy side of the order booking waiting to be matched with sell order.
-        // These are resting orders waiting to be matched lying in order book.
-        auto matches = mBidTracker.MatchQuantity(limitPrice, inBoundOrderRemaining);
+        Base::Quantity totalSwept = 0;
 
-        // std::cout<<"matchSellOrder method, size of matches: "<<matches.size()<<std::endl;
-        for (const auto& [restingOrderPtr, restingOrderRemainingQty] : matches) {
-            if (inBoundOrderRemaining == 0)
-            {
+        while (inBoundOrderRemaining > 0) {
+            mSweptOrders.clear();
+            Base::Quantity levelQty = tracker.SweepBestLevel(limitPrice, inBoundOrderRemaining, mSweptOrders);
+            if (levelQty == 0) {
                 break;
             }
-            
-            // Check all-or-none conditions
-            if (IsAllOrNone(conditions) && restingOrderRemainingQty < inBoundOrderRemaining) {
-                continue;
+
+            const Base::Timestamp now = std::chrono::high_resolution_clock::now();
+            const Base::Price levelPrice = mSweptOrders.front()->GetPrice();
+            Base::Quantity fillQty = 0;
+
+            for (const OrderPtr& restingOrderPtr : mSweptOrders) {
+                fillQty = restingOrderPtr->GetOpenQuantity();
+                Base::FillFlags flags = Base::FILL_NORMAL | (fillQty == inBoundOrderRemaining ? Base::FILL_COMPLETE : Base::FILL_PARTIAL);
+                mPendingTrades.emplace_back(inBoundOrderPtr, restingOrderPtr, fillQty, levelPrice, flags, now);
+                inBoundOrderRemaining -= fillQty;
+
+                restingOrderPtr->SetOrderStatus(Base::OrderStatus::FILLED);
+                releaseRestingOrder(restingOrderPtr);
+                restingOrderPtr->SetOpenQuantity(0);
             }
-            
-            Base::Quantity fillQty = std::min(restingOrderRemainingQty, inBoundOrderRemaining);
-            Base::Price fillPrice = restingOrderPtr->GetPrice();
-            // Execute the trade
-            executeTrade(inBoundOrderPtr, restingOrderPtr, fillQty, fillPrice);
-            
-            inBoundOrderRemaining -= fillQty;
-            anyFill = true;
-            
-            // Update order quantities
             inBoundOrderPtr->SetOpenQuantity(inBoundOrderRemaining);
-            
-            if (inBoundOrderRemaining == 0) {
-                inBoundOrderPtr->SetOrderStatus(Base::OrderStatus::FILLED);
-                break;
-            } else {
-                inBoundOrderPtr->SetOrderStatus(Base::OrderStatus::PARTIALLY_FILLED);
-            }
+            totalSwept += levelQty;
+
+            mStats.mTotalTrades += mSweptOrders.size();
+            mStats.mTotalVolume += levelQty;
+            mLastTradePrice.store(levelPrice);
+            mLastTradeQty.store(fillQty);
+            mMarketPrice.store(levelPrice);
+            mTradeAggregator.Record(levelPrice, levelQty, now, mSweptOrders.size());
         }
-        return anyFill;
+
+        if (totalSwept > 0) {
+            inBoundOrderPtr->SetOrderStatus(inBoundOrderRemaining == 0
+                ? Base::OrderStatus::FILLED
+                : Base::OrderStatus::PARTIALLY_FILLED);
+        }
+        return totalSwept;
     }
 
-    template <typename OrderPtr>
-    void OrderBook<OrderPtr>::executeTrade(const OrderPtr& inBoundOrderPtr, const OrderPtr& restingOrderPtr, Base::Quantity quantity, Base::Price price)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    template <Base::OrderSide RestingSide>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::executeTrade(const OrderPtr& inBoundOrderPtr, const OrderPtr& restingOrderPtr, Base::Quantity quantity, Base::Price price)
     {
         Base::FillFlags flags = Base::FILL_NORMAL;
         if (inBoundOrderPtr->GetOpenQuantity() == quantity){
@@ -248,54 +528,43 @@ namespace OrderEngine {
         mLastTradePrice.store(price);
         mLastTradeQty.store(quantity);
         mMarketPrice.store(price);
+        mTradeAggregator.Record(price, quantity, trade.mTimestamp);
 
         // Update resting order
+        // The tracker sets the new open quantity itself, it needs the old one to keep the level total right
         Base::Quantity restingRemainingQty = restingOrderPtr->GetOpenQuantity() - quantity;
-        restingOrderPtr->SetOpenQuantity(restingRemainingQty);
 
         if (restingRemainingQty == 0) 
         {
             restingOrderPtr->SetOrderStatus(Base::OrderStatus::FILLED);
 
             // Remove the order from the order tracker
-            if (restingOrderPtr->isBuy())
-            {
-                mBidTracker.RemoveOrder(restingOrderPtr);
-            }
-            else // Sell
-            {
-                mAskTracker.RemoveOrder(restingOrderPtr);
-            }
+            trackerFor<RestingSide>().RemoveOrder(restingOrderPtr);
+            releaseRestingOrder(restingOrderPtr);
+            restingOrderPtr->SetOpenQuantity(0);
         } 
         else 
         {
             restingOrderPtr->SetOrderStatus(Base::OrderStatus::PARTIALLY_FILLED);
 
             // Update the order quantity in the tracker
-            if(restingOrderPtr->isBuy())
-            {
-                mBidTracker.UpdateOrderQuantity(restingOrderPtr, restingRemainingQty);
-            }
-            else 
-            {
-                mAskTracker.UpdateOrderQuantity(restingOrderPtr, restingRemainingQty);
-            }
+            trackerFor<RestingSide>().UpdateOrderQuantity(restingOrderPtr, restingRemainingQty);
         }
 
         // todo: log the trade
         // todo: notify trade listeners that trade is executed
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::isImmediateOrCancel(const Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::isImmediateOrCancel(const Base::OrderConditions conditions)
     {
-        return (conditions & Base::IMMEDIATE_OR_CANCEL) == 1;
+        return (conditions & Base::IMMEDIATE_OR_CANCEL) != 0;
     }
 
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::IsAllOrNone(const Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::IsAllOrNone(const Base::OrderConditions conditions)
     {
-        return (conditions & Base::ALL_OR_NONE) == 1;
+        return (conditions & Base::ALL_OR_NONE) != 0;
     }
 
     /**
@@ -303,17 +572,13 @@ namespace OrderEngine {
      * @details
      * - Attemps to match order, if unmatched add remaining quantity to the order book.
      */
-    template <typename OrderPtr>
-    bool OrderBook<OrderPtr>::processLimitOrder(const OrderPtr& inBoundOrderPtr, const Base::OrderConditions conditions)
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::processLimitOrder(const OrderPtr& inBoundOrderPtr, const Base::OrderConditions conditions)
     {
         // Order* inBoundOrderPtr = new Order();
-        bool isFilled = false;
-        if(inBoundOrderPtr->isBuy()){
-            isFilled = matchBuyOrder(inBoundOrderPtr, conditions, inBoundOrderPtr->GetPrice());
-        }
-        else {
-            isFilled = matchSellOrder(inBoundOrderPtr, conditions, inBoundOrderPtr->GetPrice());
-        }
+        bool isFilled = inBoundOrderPtr->isBuy()
+            ? matchOrder<Base::OrderSide::BUY>(inBoundOrderPtr, conditions, inBoundOrderPtr->GetPrice())
+            : matchOrder<Base::OrderSide::SELL>(inBoundOrderPtr, conditions, inBoundOrderPtr->GetPrice());
 
         // If order has remaining quantity and is not IOC (Immediate or Cancel) : Add in order book
         if (inBoundOrderPtr->GetOpenQuantity() > 0) 
@@ -336,5 +601,303 @@ namespace OrderEngine {
         
         return isFilled;
     }
-    template class OrderBook<Order*>;
+    // <===================================== Auction =====================================>
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::startAuction()
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mPhase.store(Base::TradingPhase::AUCTION);
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    Base::TradingPhase OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::getTradingPhase() const
+    {
+        return mPhase.load();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    AuctionResult OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::uncrossAuction(Base::Price referencePrice)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mPhase.store(Base::TradingPhase::CONTINUOUS);
+
+        if (mBidTracker.IsEmpty() || mAskTracker.IsEmpty()) {
+            return {};
+        }
+
+        // Only levels inside the crossed range can trade: bids at or above the best ask,
+        // asks at or below the best bid
+        mAuctionBidLevels.clear();
+        mAuctionAskLevels.clear();
+        mBidTracker.GetLevels(mAskTracker.GetBestPrice(), mAuctionBidLevels);
+        mAskTracker.GetLevels(mBidTracker.GetBestPrice(), mAuctionAskLevels);
+
+        AuctionResult result = mAuctionCalculator.Compute(mAuctionBidLevels, mAuctionAskLevels, referencePrice);
+        if (!result.mCrossed) {
+            return result;
+        }
+
+        // Both sides hold at least mVolume at or through the equilibrium price
+        mAuctionBidFills.clear();
+        mAuctionAskFills.clear();
+        mBidTracker.MatchQuantity(result.mPrice, result.mVolume, mMatchingPolicy, mAuctionBidFills);
+        mAskTracker.MatchQuantity(result.mPrice, result.mVolume, mMatchingPolicy, mAuctionAskFills);
+
+        // Pair the two fill lists in priority order, every trade prints at the equilibrium price.
+        // The buy order is recorded as the inbound side, an auction has no aggressor.
+        size_t bidIdx = 0;
+        size_t askIdx = 0;
+        size_t firstTrade = mPendingTrades.size();
+        Base::Quantity bidLeft = mAuctionBidFills.empty() ? 0 : mAuctionBidFills[0].second;
+        Base::Quantity askLeft = mAuctionAskFills.empty() ? 0 : mAuctionAskFills[0].second;
+
+        while (bidIdx < mAuctionBidFills.size() && askIdx < mAuctionAskFills.size()) {
+            const OrderPtr& buyOrder = mAuctionBidFills[bidIdx].first;
+            const OrderPtr& sellOrder = mAuctionAskFills[askIdx].first;
+            Base::Quantity fillQty = std::min(bidLeft, askLeft);
+
+            Base::FillFlags flags = bidLeft == fillQty ? Base::FILL_COMPLETE : Base::FILL_PARTIAL;
+            mPendingTrades.emplace_back(buyOrder, sellOrder, fillQty, result.mPrice, flags);
+            mStats.mTotalTrades++;
+
+            bidLeft -= fillQty;
+            askLeft -= fillQty;
+            if (bidLeft == 0 && ++bidIdx < mAuctionBidFills.size()) {
+                bidLeft = mAuctionBidFills[bidIdx].second;
+            }
+            if (askLeft == 0 && ++askIdx < mAuctionAskFills.size()) {
+                askLeft = mAuctionAskFills[askIdx].second;
+            }
+        }
+
+        // Apply all fills to the trackers in bulk, then settle order statuses
+        mBidTracker.ApplyFills(mAuctionBidFills);
+        mAskTracker.ApplyFills(mAuctionAskFills);
+
+        for (const auto* fills : {&mAuctionBidFills, &mAuctionAskFills}) {
+            for (const auto& [order, qty] : *fills) {
+                if (order->GetOpenQuantity() == 0) {
+                    order->SetOrderStatus(Base::OrderStatus::FILLED);
+                    releaseRestingOrder(order);
+                }
+                else {
+                    order->SetOrderStatus(Base::OrderStatus::PARTIALLY_FILLED);
+                }
+            }
+        }
+
+        mStats.mTotalVolume += result.mVolume;
+        mLastTradePrice.store(result.mPrice);
+        mLastTradeQty.store(result.mVolume);
+        mMarketPrice.store(result.mPrice);
+        mTradeAggregator.Record(result.mPrice, result.mVolume, std::chrono::high_resolution_clock::now(),
+                                mPendingTrades.size() - firstTrade);
+        onBookUpdated();
+
+        return result;
+    }
+
+    // <===================================== Cancel =====================================>
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    bool OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::cancelOrder(Base::OrderId orderId)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+
+        OrderPtr order = mBidTracker.FindOrder(orderId);
+        if (order) {
+            mBidTracker.RemoveOrder(order);
+        }
+        else if ((order = mAskTracker.FindOrder(orderId))) {
+            mAskTracker.RemoveOrder(order);
+        }
+        else {
+            return false;
+        }
+
+        releaseRestingOrder(order);
+        order->SetOrderStatus(Base::OrderStatus::CANCELLED);
+        mStats.mTotalOrdersCancelled++;
+        onBookUpdated();
+        // todo: notifyOrderCancelled
+        return true;
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::cancelAllOrders()
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mCancelledOrders.clear();
+        mBidTracker.RemoveAll(mCancelledOrders);
+        mAskTracker.RemoveAll(mCancelledOrders);
+
+        // The book is empty, so every owner list goes with it
+        mOwnerIndex.Clear();
+        for (const auto& order : mCancelledOrders) {
+            order->SetPrevByOwner(nullptr);
+            order->SetNextByOwner(nullptr);
+            mExpiryWheel.Disarm(order->GetExpiryTimer());
+            order->SetExpiryTimer(TimerWheel::kNoTimer);
+            order->SetOrderStatus(Base::OrderStatus::CANCELLED);
+        }
+        mStats.mTotalOrdersCancelled += mCancelledOrders.size();
+        onBookUpdated();
+        return mCancelledOrders.size();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::cancelSide(Base::OrderSide side)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mCancelledOrders.clear();
+        if (side == Base::OrderSide::BUY) {
+            mBidTracker.RemoveAll(mCancelledOrders);
+        }
+        else {
+            mAskTracker.RemoveAll(mCancelledOrders);
+        }
+        return finishMassCancel();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::cancelPriceRange(Base::OrderSide side, Base::Price lowPrice, Base::Price highPrice)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mCancelledOrders.clear();
+        if (side == Base::OrderSide::BUY) {
+            mBidTracker.RemoveLevels(lowPrice, highPrice, mCancelledOrders);
+        }
+        else {
+            mAskTracker.RemoveLevels(lowPrice, highPrice, mCancelledOrders);
+        }
+        return finishMassCancel();
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::cancelOwnerOrders(Base::OwnerId owner)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        size_t cancelled = 0;
+
+        while (Order* order = mOwnerIndex.Head(owner)) {
+            if (order->isBuy()) {
+                mBidTracker.RemoveOrder(order);
+            }
+            else {
+                mAskTracker.RemoveOrder(order);
+            }
+            releaseRestingOrder(order);
+            order->SetOrderStatus(Base::OrderStatus::CANCELLED);
+            ++cancelled;
+        }
+
+        mStats.mTotalOrdersCancelled += cancelled;
+        onBookUpdated();
+        return cancelled;
+    }
+
+    /**
+     * @method finishMassCancel
+     * @details Settles the orders a level drop left in mCancelledOrders: owner lists and status.
+     */
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::finishMassCancel()
+    {
+        for (const auto& order : mCancelledOrders) {
+            releaseRestingOrder(order);
+            order->SetOrderStatus(Base::OrderStatus::CANCELLED);
+        }
+        mStats.mTotalOrdersCancelled += mCancelledOrders.size();
+        onBookUpdated();
+        return mCancelledOrders.size();
+    }
+
+    // <===================================== Expiry =====================================>
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    uint64_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::toExpiryTick(Base::Timestamp time)
+    {
+        // One wheel tick per millisecond
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count());
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::armExpiry(const OrderPtr& order)
+    {
+        Base::Timestamp expireTime;
+        switch (order->GetTimeInForce()) {
+            case Base::TimeInForce::GTD:
+            case Base::TimeInForce::GTT:
+                expireTime = order->GetExpireTime();
+                break;
+            case Base::TimeInForce::DAY:
+                if (mSessionClose == Base::Timestamp::max()) return;
+                expireTime = mSessionClose;
+                break;
+            default:
+                return;
+        }
+        // A clock nobody started begins at the first arrival, a later order may well expire sooner
+        mExpiryWheel.Start(toExpiryTick(order->GetCreatedAt()));
+        order->SetExpiryTimer(mExpiryWheel.Arm(toExpiryTick(expireTime), order->GetId()));
+    }
+
+    /**
+     * @method releaseRestingOrder
+     * @details Detaches an order that left the book from its owner list and its expiry timer.
+     */
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::releaseRestingOrder(const OrderPtr& order)
+    {
+        mOwnerIndex.Unlink(order);
+        if (order->GetExpiryTimer() != TimerWheel::kNoTimer) {
+            mExpiryWheel.Disarm(order->GetExpiryTimer());
+            order->SetExpiryTimer(TimerWheel::kNoTimer);
+        }
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    void OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::startExpiryClock(Base::Timestamp now)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mExpiryWheel.Start(toExpiryTick(now));
+    }
+
+    template <typename OrderPtr, typename MatchingPolicy, typename ConcurrencyPolicy>
+    size_t OrderBook<OrderPtr, MatchingPolicy, ConcurrencyPolicy>::expireOrders(Base::Timestamp now)
+    {
+        std::lock_guard<Mutex> lock(mBookMutex);
+        mExpiredOrderIds.clear();
+        mExpiryWheel.Advance(toExpiryTick(now), mExpiredOrderIds);
+
+        size_t expired = 0;
+        for (Base::OrderId orderId : mExpiredOrderIds) {
+            OrderPtr order = mBidTracker.FindOrder(orderId);
+            if (order) {
+                mBidTracker.RemoveOrder(order);
+            }
+            else if ((order = mAskTracker.FindOrder(orderId))) {
+                mAskTracker.RemoveOrder(order);
+            }
+            else {
+                continue;
+            }
+
+            // The wheel already released the timer
+            order->SetExpiryTimer(TimerWheel::kNoTimer);
+            mOwnerIndex.Unlink(order);
+            order->SetOrderStatus(Base::OrderStatus::EXPIRED);
+            ++expired;
+        }
+
+        mStats.mTotalOrdersExpired += expired;
+        onBookUpdated();
+        return expired;
+    }
+
+    template class OrderBook<Order*, FifoPolicy>;
+    template class OrderBook<Order*, ProRataPolicy>;
+    template class OrderBook<Order*, TopOrderProRataPolicy>;
+    template class OrderBook<Order*, FifoPolicy, SingleThreadedPolicy>;
+    template class OrderBook<Order*, ProRataPolicy, SingleThreadedPolicy>;
+    template class OrderBook<Order*, TopOrderProRataPolicy, SingleThreadedPolicy>;
 } // OrderEngine
\ No newline at end of file
@@ -7,6 +7,14 @@
 
 #include "../OrderTypes.h"
 #include "../OrderTracker/OrderTracker.h"
+#include "AuctionCalculator.h"
+#include "OwnerIndex.h"
+#include "DepthSnapshot.h"
+#include "SnapshotPublisher.h"
+#include "ConcurrencyPolicy.h"
+#include "../Timer/TimerWheel.h"
+#include "../Monitoring/LatencyHistogram.h"
+#include "../Monitoring/StatsSegment.h"
 
 namespace OrderEngine {
     /**
@@ -31,26 +39,41 @@ namespace OrderEngine {
             Base::Price p, Base::FillFlags f = Base::FILL_NORMAL)
                 :mInBoundOrder(inBoundOrder),mRestingOrder(restingOrder),mQuantity(qty),mPrice(p),
         mTimestamp(std::chrono::high_resolution_clock::now()),mFlags(f){}
+
+        // Fills of one sweep share the timestamp taken once for the whole level
+        TradeExecution(const OrderPtr& inBoundOrder,const OrderPtr& restingOrder, Base::Quantity qty,
+            Base::Price p, Base::FillFlags f, Base::Timestamp timestamp)
+                :mInBoundOrder(inBoundOrder),mRestingOrder(restingOrder),mQuantity(qty),mPrice(p),
+        mTimestamp(timestamp),mFlags(f){}
     };
 
     /**
      * @brief Structure for tracking order book statistics.
      * @details
-     * OrderBookStats maintains atomic counters for various order book events, allowing
-     * for thread-safe tracking of metrics such as total orders added, cancelled, replaced,
-     * trades executed, volume traded, and orders rejected.
+     * OrderBookStats maintains counters for various order book events such as total orders
+     * added, cancelled, replaced, trades executed, volume traded, and orders rejected.
+     * They are atomics readable from any thread under ThreadSafePolicy, plain integers
+     * for the owning thread only under SingleThreadedPolicy.
      */
-    struct OrderBookStats
+    template<typename ConcurrencyPolicy = ThreadSafePolicy> struct OrderBookStats
     {
-        std::atomic<uint64_t> mTotalOrdersAdded{0};
-        std::atomic<uint64_t> mTotalOrdersCancelled{0};
-        std::atomic<uint64_t> mTotalOrdersReplaced{0};
-        std::atomic<uint64_t> mTotalTrades{0};
-        std::atomic<uint64_t> mTotalVolume{0};
-        std::atomic<uint64_t> mTotalRejected{0};
+        template<typename T> using Atomic = typename ConcurrencyPolicy::template Atomic<T>;
+
+        Atomic<uint64_t> mTotalOrdersAdded{0};
+        Atomic<uint64_t> mTotalOrdersCancelled{0};
+        Atomic<uint64_t> mTotalOrdersReplaced{0};
+        Atomic<uint64_t> mTotalTrades{0};
+        Atomic<uint64_t> mTotalVolume{0};
+        Atomic<uint64_t> mTotalRejected{0};
+        Atomic<uint64_t> mTotalOrdersExpired{0};
+
+        // Price level pool occupancy (gauges, refreshed after every book operation)
+        Atomic<uint64_t> mPriceLevelsInUse{0};
+        Atomic<uint64_t> mPriceLevelsCapacity{0};
 
         void reset()
         {
+            mTotalOrdersExpired = 0;
             mTotalTrades = 0;
             mTotalRejected = 0;
             mTotalVolume=0;
@@ -60,6 +83,24 @@ namespace OrderEngine {
         }
     };
 
+    /**
+     * @struct OrderBookConfig
+     * @brief Capacities a book reserves at construction.
+     * @details Sized for the session's peak, with an Arena, add/cancel/match never allocate once
+     *          warmed up: every buffer they touch is pooled, reused or already at its peak capacity.
+     *          Zero-allocation mode needs the arena: without one, every price level that opens
+     *          still costs a std::map node from the global heap, and every level that closes frees it.
+     */
+    struct OrderBookConfig
+    {
+        size_t mReservedLevels = 64;        // Pooled price levels, shared by both sides
+        size_t mOrdersPerLevel = 0;         // Queue slots each pooled level starts with
+        size_t mReservedOrders = 0;         // Resting orders per side in the location index and expiry wheel
+        size_t mReservedTrades = 1000;      // Executions queued between drainTrades calls
+        size_t mReservedFills = 1000;       // Fills and swept/cancelled orders of one operation
+        size_t mImbalanceLevels = 5;        // Levels per side behind the snapshot's imbalance and microprice
+    };
+
     /**
      * @class OrderBook
      * @tparam OrderPtr
@@ -70,58 +111,282 @@ namespace OrderEngine {
      * 2. Provides performance isolation
      * 3. Circuit breakers can be implemented per stock
      *
+     * @tparam MatchingPolicy How a level's quantity is allocated across its orders (see MatchingPolicy.h)
+     * @tparam ConcurrencyPolicy Book lock and counters, shared or single-threaded (see ConcurrencyPolicy.h)
      */
-    template<typename OrderPtr> class OrderBook
+    template<typename OrderPtr, typename MatchingPolicy = FifoPolicy, typename ConcurrencyPolicy = ThreadSafePolicy>
+    class OrderBook
     {
     public:
-        using OrderTracker = OrderTracker<OrderPtr>;
+        using BidTracker = OrderTracker<OrderPtr, Base::OrderSide::BUY>;
+        using AskTracker = OrderTracker<OrderPtr, Base::OrderSide::SELL>;
         using TradeExecution = TradeExecution<OrderPtr>;
+        using Stats = OrderBookStats<ConcurrencyPolicy>;
     private:
+        template<typename T> using Atomic = typename ConcurrencyPolicy::template Atomic<T>;
+        using Mutex = typename ConcurrencyPolicy::Mutex;
+
         Base::Symbol mSymbol;
-        OrderTracker mBidTracker;
-        OrderTracker mAskTracker;
-        OrderTracker mStopBidTracker;
-        OrderTracker mStopAskTracker;
+        // Must be declared before the trackers, they reference it
+        PriceLevelPool<OrderPtr> mLevelPool;
+        BidTracker mBidTracker;
+        AskTracker mAskTracker;
+        BidTracker mStopBidTracker;
+        AskTracker mStopAskTracker;
 
         // Market States
-        std::atomic<Base::Price> mMarketPrice{};
-        std::atomic<Base::Price> mLastTradePrice{};
-        std::atomic<Base::Quantity> mLastTradeQty{};
+        Atomic<Base::Price> mMarketPrice{};
+        Atomic<Base::Price> mLastTradePrice{};
+        Atomic<Base::Quantity> mLastTradeQty{};
+        Atomic<Base::TradingPhase> mPhase{Base::TradingPhase::CONTINUOUS};
+
+        // Allocation within a level, empty for FIFO
+        MatchingPolicy mMatchingPolicy;
 
         // Statistics
-        OrderBookStats mStats;
+        Stats mStats;
 
         // Thread safety
-        mutable std::recursive_mutex mBookMutex;
+        mutable Mutex mBookMutex;
 
         // Trade execution queue for batch processing
-        std::vector<TradeExecution> mPendingTrades;
+        std::vector<TradeExecution, ArenaAllocator<TradeExecution>> mPendingTrades;
+
+        // Resting orders grouped by owner, for per-owner mass cancel
+        OwnerIndex mOwnerIndex;
+        // Orders removed by a mass cancel, reused across calls
+        std::vector<OrderPtr> mCancelledOrders;
+        // Orders of a level taken whole by an aggressor, reused across calls
+        std::vector<OrderPtr> mSweptOrders;
+        // Fills of the level an aggressor takes in part, reused across calls
+        typename BidTracker::Fills mMatches;
+
+        // OHLCV/VWAP bars, fed with every fill
+        TradeAggregator mTradeAggregator;
+
+        // Lock-free depth view for reader threads
+        SnapshotPublisher<DepthSnapshot> mSnapshots;
+        uint64_t mSnapshotVersion = 0;
+        bool mPublishSnapshots = true;
+        DepthListener* mDepthListener = nullptr;
+
+        // addOrder latency, recorded into the attached stats record if there is one
+        LatencyHistogram mAddOrderLatency;
+        LatencyHistogram* mLatencySink = &mAddOrderLatency;
+        // Out-of-process view of the stats, see StatsSegment
+        BookStatsRecord* mStatsRecord = nullptr;
+
+        // Expiry of DAY/GTD/GTT orders, driven by expireOrders() on the book thread
+        TimerWheel mExpiryWheel;
+        std::vector<uint64_t> mExpiredOrderIds;
+        Base::Timestamp mSessionClose{Base::Timestamp::max()};
+
+        // Auction scratch space, reused across uncrosses
+        AuctionCalculator mAuctionCalculator;
+        std::vector<Base::LevelInfo> mAuctionBidLevels;
+        std::vector<Base::LevelInfo> mAuctionAskLevels;
+        std::vector<std::pair<OrderPtr, Base::Quantity>> mAuctionBidFills;
+        std::vector<std::pair<OrderPtr, Base::Quantity>> mAuctionAskFills;
 
     public:
-        explicit OrderBook(Base::Symbol  symbol);
+        static constexpr size_t kDefaultReservedLevels = 64;
+
+        /**
+         * @param arena Per-shard arena for the book's containers, shared by all books of the
+         *              owning worker. Null keeps everything on the global heap, where price
+         *              level tree nodes are allocated and freed as levels open and close.
+         */
+        explicit OrderBook(Base::Symbol  symbol, size_t reservedLevels = kDefaultReservedLevels,
+                           Arena* arena = nullptr);
+
+        // Every capacity taken from config, see OrderBookConfig
+        OrderBook(Base::Symbol symbol, const OrderBookConfig& config, Arena* arena = nullptr);
         ~OrderBook() = default;
 
         // ========== Configuration ==========
 
         void setMarketPrice(Base::Price price);
 
+        const Stats& getStats() const;
+
+        // ========== Depth snapshots ==========
+
+        /**
+         * @brief Copies the latest published depth view, callable from any thread.
+         * @details Never takes mBookMutex, readers do not delay the matching thread.
+         */
+        void getDepthSnapshot(DepthSnapshot& snapshot) const;
+
+        // Publication is on by default, books without readers can skip its cost
+        void setSnapshotPublishing(bool enabled);
+
+        /**
+         * @brief Hands every published snapshot to listener right after publication, nullptr detaches.
+         * @details Only called while snapshot publishing is on, see DepthConflator for a listener
+         *          that fans depth out to subscribers without blocking the book.
+         */
+        void setDepthListener(DepthListener* listener);
+
+        /**
+         * @brief Levels per side summed for the snapshot's imbalance and microprice.
+         * @details The sums are kept by the trackers as levels change, a snapshot reads them in O(1).
+         *          Setting it re-sums that many levels once; 1 gives the classic top-of-book microprice.
+         */
+        void setImbalanceLevels(size_t levels);
+
+        /**
+         * @brief Appends every level of one side to levels, best price first.
+         * @details Full depth, taken under the book lock. Readers that only need the top of
+         *          the book should use getDepthSnapshot().
+         */
+        void getLevels(Base::OrderSide side, std::vector<Base::LevelInfo>& levels) const;
+
+        /**
+         * @brief Hash of the full resting state: every order's id, side, price, open quantity and queue position.
+         * @details
+         * - Maintained incrementally (see PriceTracker::LinkHash), reading it costs O(1) whatever the depth.
+         * - Two books hold the same orders in the same queue positions exactly when their checksums
+         *   match (up to hash collisions), so replicas, replays and restores compare this one value.
+         */
+        uint64_t getChecksum() const;
+
+        // Hash of one level's orders, 0 if there is no level at price; localizes a checksum mismatch
+        uint64_t getLevelChecksum(Base::OrderSide side, Base::Price price) const;
+
+        /**
+         * @brief How much is ahead of a resting order: live orders and open quantity queued before it in its level.
+         * @details O(log n) in the level's queue length, backed by the level's Fenwick tree over queue slots.
+         *          The rank is time priority; pro-rata books allocate by size but still use it for remainders.
+         * @return false if no resting order has this id
+         */
+        bool queuePosition(Base::OrderId orderId, Base::QueuePosition& position) const;
+
+        // True while the book references the order: resting, or waiting on its stop trigger
+        bool holdsOrder(const OrderPtr& order) const;
+
+        // ========== Executions ==========
+
+        /**
+         * @brief Sets the bar intervals of the trade statistics (default 1s and 1m) and clears all bars.
+         * @details At most TradeStatistics::kMaxIntervals intervals are kept.
+         */
+        void setBarIntervals(const std::vector<std::chrono::nanoseconds>& intervals);
+
+        /**
+         * @brief Moves the executions queued since the last call to the end of trades.
+         * @details Executions come out in the order they happened. The queue keeps its capacity.
+         * @return Number of executions moved
+         */
+        size_t drainTrades(std::vector<TradeExecution>& trades);
+
+        // ========== Monitoring ==========
+
+        /**
+         * @brief Mirrors this book's counters, gauges and latency histogram into a shared memory record.
+         * @details The record is refreshed with relaxed stores after every book operation, pass nullptr to detach.
+         */
+        void attachStatsRecord(BookStatsRecord* record);
+
+        const LatencyHistogram& getAddOrderLatency() const;
+
+        // Time DAY orders expire at, DAY orders never expire while it is unset
+        void setSessionClose(Base::Timestamp sessionClose);
+
+        /**
+         * @brief Static checks addOrder runs before matching (symbol, quantities, prices, expiry).
+         * @details Reads no book state, safe from any thread, e.g. a gateway rejecting early.
+         */
+        bool validateOrder(const OrderPtr& order) const;
+
         bool addOrder(const OrderPtr& order, Base::OrderConditions conditions = Base::NO_CONDITIONS);
+
+        // ========== Auction ==========
+
+        /**
+         * @brief Switches the book into the call phase.
+         * @details
+         * - Limit orders rest in mBidTracker/mAskTracker without matching, even if they cross.
+         * - Market and IOC orders are rejected, they have no meaning before the uncross.
+         */
+        void startAuction();
+
+        /**
+         * @brief Ends the call phase and executes all crossing orders at a single equilibrium price.
+         * @param referencePrice Used to break ties between equally good prices (e.g. previous close)
+         * @details
+         * - The equilibrium price comes from AuctionCalculator.
+         * - Both sides are filled in price-time priority up to the executable volume, and the
+         *   fills are applied to each tracker in one bulk pass.
+         * - The book returns to continuous trading afterwards.
+         */
+        AuctionResult uncrossAuction(Base::Price referencePrice);
+
+        Base::TradingPhase getTradingPhase() const;
+
+        // ========== Cancel ==========
+
+        bool cancelOrder(Base::OrderId orderId);
+
+        /**
+         * Mass cancels, each returns the number of orders cancelled.
+         * - Whole price levels are dropped at once and the location index is cleared in bulk.
+         * - cancelOwnerOrders walks the owner's intrusive order list, so it costs only the
+         *   orders it cancels.
+         */
+        size_t cancelAllOrders();
+        size_t cancelSide(Base::OrderSide side);
+        size_t cancelPriceRange(Base::OrderSide side, Base::Price lowPrice, Base::Price highPrice);
+        size_t cancelOwnerOrders(Base::OwnerId owner);
+
+        // ========== Expiry ==========
+
+        /**
+         * @brief Expires every DAY/GTD/GTT order due at or before now.
+         * @details
+         * - Meant to be called periodically from the book thread, e.g. once per event loop turn.
+         * - Due orders come out of the timer wheel in one batch, nothing scans the resting orders.
+         * - Expiry runs on the times the caller passes in (see startExpiryClock).
+         * @return Number of orders expired
+         */
+        size_t expireOrders(Base::Timestamp now);
+
+        /**
+         * @brief Starts the expiry clock at now, a no-op once it has started.
+         * @details Without it the clock starts at the first expireOrders time, or at the arrival
+         *          (construction time) of the first order armed with a deadline. Replays call it
+         *          with the log's time, since their orders are constructed at replay time.
+         */
+        void startExpiryClock(Base::Timestamp now);
     private:
-        void rejectOrder(const OrderPtr& order, const std::string& reason);
-        bool validateOrder(const OrderPtr& order) const;
+        void rejectOrder(const OrderPtr& order, const char* reason);
         bool processMarketOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions);
-        bool matchMarketBuyOrder(const OrderPtr& order, Base::OrderConditions conditions);
-        bool matchBuyOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice);
-        bool matchMarketSellOrder(const OrderPtr& order, Base::OrderConditions conditions);
-        bool matchSellOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice);
+        // Side-generic matching, instantiated once per inbound side
+        template<Base::OrderSide Side> auto& trackerFor();
+        template<Base::OrderSide Side> bool matchMarketOrder(const OrderPtr& order, Base::OrderConditions conditions);
+        template<Base::OrderSide Side> bool matchOrder(const OrderPtr& inBoundOrderPtr, Base::OrderConditions conditions, Base::Price limitPrice);
         void addRestingOrder(const OrderPtr& order);
         bool processLimitOrder(const OrderPtr& inBoundOrderPtr, const Base::OrderConditions conditions);
+        template<Base::OrderSide RestingSide> Base::Quantity sweepLevels(const OrderPtr& inBoundOrderPtr, Base::Price limitPrice);
+        template<Base::OrderSide RestingSide>
         void executeTrade(const OrderPtr& inBoundOrderPtr, const OrderPtr& restingOrderPtr, Base::Quantity quantity, Base::Price price);
+        size_t finishMassCancel();
+        bool processOrder(const OrderPtr& order, Base::OrderConditions conditions);
+        void onBookUpdated();
+        void writeStatsRecord();
+        void publishSnapshot();
+        void armExpiry(const OrderPtr& order);
+        void releaseRestingOrder(const OrderPtr& order);
+        static uint64_t toExpiryTick(Base::Timestamp time);
         static bool IsAllOrNone(Base::OrderConditions conditions);
         static bool isImmediateOrCancel(Base::OrderConditions conditions);
     };
 
-    extern template class OrderBook<Order*>;
+    extern template class OrderBook<Order*, FifoPolicy>;
+    extern template class OrderBook<Order*, ProRataPolicy>;
+    extern template class OrderBook<Order*, TopOrderProRataPolicy>;
+    extern template class OrderBook<Order*, FifoPolicy, SingleThreadedPolicy>;
+    extern template class OrderBook<Order*, ProRataPolicy, SingleThreadedPolicy>;
+    extern template class OrderBook<Order*, TopOrderProRataPolicy, SingleThreadedPolicy>;
 };
 
 
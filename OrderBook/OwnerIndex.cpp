@@ -0,0 +1,57 @@
+#include "OwnerIndex.h"
+
+namespace OrderEngine {
+
+    OwnerIndex::OwnerIndex(Arena* arena)
+        : mHeads(0, std::hash<Base::OwnerId>(), std::equal_to<Base::OwnerId>(),
+                 ArenaAllocator<std::pair<const Base::OwnerId, Order*>>(arena))
+    {
+    }
+
+    void OwnerIndex::Link(Order* order)
+    {
+        Order*& head = mHeads[order->GetOwner()];
+        order->SetPrevByOwner(nullptr);
+        order->SetNextByOwner(head);
+        if (head) {
+            head->SetPrevByOwner(order);
+        }
+        head = order;
+    }
+
+    void OwnerIndex::Unlink(Order* order)
+    {
+        Order* prev = order->GetPrevByOwner();
+        Order* next = order->GetNextByOwner();
+
+        if (prev) {
+            prev->SetNextByOwner(next);
+        }
+        else {
+            auto it = mHeads.find(order->GetOwner());
+            if (it == mHeads.end() || it->second != order) {
+                return; // Not linked
+            }
+            it->second = next;
+        }
+
+        if (next) {
+            next->SetPrevByOwner(prev);
+        }
+        order->SetPrevByOwner(nullptr);
+        order->SetNextByOwner(nullptr);
+    }
+
+    Order* OwnerIndex::Head(Base::OwnerId owner) const
+    {
+        auto it = mHeads.find(owner);
+        return it == mHeads.end() ? nullptr : it->second;
+    }
+
+    void OwnerIndex::Clear()
+    {
+        for (auto& [owner, head] : mHeads) {
+            head = nullptr;
+        }
+    }
+} // namespace OrderEngine
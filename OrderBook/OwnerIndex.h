@@ -0,0 +1,40 @@
+#pragma once
+#ifndef OWNER_INDEX_H
+#define OWNER_INDEX_H
+
+#include <unordered_map>
+#include "../Order.h"
+#include "../Memory/Arena.h"
+
+namespace OrderEngine {
+    /**
+     * @class OwnerIndex
+     * @brief Resting orders of the book grouped by owner (session or account).
+     * @details
+     * - Each owner's orders form an intrusive doubly linked list threaded through the
+     *   Order objects themselves, only the list heads live in this index.
+     * - Link/Unlink are O(1) and never allocate once an owner has been seen.
+     * - Walking an owner's list costs only that owner's orders, independent of book size.
+     */
+    class OwnerIndex
+    {
+    public:
+        explicit OwnerIndex(Arena* arena = nullptr);
+
+        void Link(Order* order);
+        void Unlink(Order* order);
+
+        // First order of the owner's list, nullptr if the owner has no resting orders
+        Order* Head(Base::OwnerId owner) const;
+
+        // Drops every list at once, hooks of the orders are not touched
+        void Clear();
+
+    private:
+        // Owners stay in the map with a nullptr head after their last order leaves
+        std::unordered_map<Base::OwnerId, Order*, std::hash<Base::OwnerId>, std::equal_to<Base::OwnerId>,
+                           ArenaAllocator<std::pair<const Base::OwnerId, Order*>>> mHeads;
+    };
+} // namespace OrderEngine
+
+#endif //OWNER_INDEX_H
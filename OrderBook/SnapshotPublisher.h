@@ -0,0 +1,82 @@
+#pragma once
+#ifndef SNAPSHOT_PUBLISHER_H
+#define SNAPSHOT_PUBLISHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace OrderEngine {
+    /**
+     * @class SnapshotPublisher
+     * @tparam T Trivially copyable snapshot type
+     * @brief Single-writer, many-reader publication of an immutable value without locks.
+     *
+     * @details
+     * - Two buffers, each guarded by its own sequence counter (a seqlock per buffer).
+     * - The writer always fills the buffer readers are NOT pointed at, then flips mActive.
+     *   A reader only has to retry if the writer laps it twice during one copy.
+     * - The writer never waits for readers and readers never block each other, so any
+     *   number of analytics/risk/UI threads can poll at any rate without slowing the writer.
+     * - Publication cost is one copy of T plus a few stores.
+     */
+    template<typename T> class SnapshotPublisher
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshots are copied while they may be rewritten");
+
+    public:
+        /**
+         * @brief Returns the buffer to fill for the next publication. Writer thread only.
+         */
+        T& BeginWrite()
+        {
+            Slot& slot = mSlots[mActive.load(std::memory_order_relaxed) ^ 1u];
+            // Odd sequence: write in progress
+            slot.mSequence.store(slot.mSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            return slot.mData;
+        }
+
+        /**
+         * @brief Makes the buffer filled since BeginWrite() visible to readers. Writer thread only.
+         */
+        void EndWrite()
+        {
+            uint32_t next = mActive.load(std::memory_order_relaxed) ^ 1u;
+            Slot& slot = mSlots[next];
+            slot.mSequence.store(slot.mSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            mActive.store(next, std::memory_order_release);
+        }
+
+        /**
+         * @brief Copies the latest published value into out. Safe from any thread.
+         */
+        void Read(T& out) const
+        {
+            while (true) {
+                const Slot& slot = mSlots[mActive.load(std::memory_order_acquire)];
+                uint64_t before = slot.mSequence.load(std::memory_order_acquire);
+                if (before & 1u) {
+                    continue; // Writer lapped us and is rewriting this buffer
+                }
+                out = slot.mData;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.mSequence.load(std::memory_order_relaxed) == before) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> mSequence{0};
+            T mData{};
+        };
+
+        Slot mSlots[2];
+        std::atomic<uint32_t> mActive{0};
+    };
+} // namespace OrderEngine
+
+#endif //SNAPSHOT_PUBLISHER_H
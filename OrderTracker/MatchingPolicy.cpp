@@ -0,0 +1,46 @@
+#include "MatchingPolicy.h"
+
+namespace OrderEngine
+{
+    void ProRataPolicy::Allocate(const Base::Quantity* quantities, size_t count, Base::Quantity total,
+                                 Base::Quantity fillQty, Base::Quantity* allocations)
+    {
+        // ==== Proportional shares, rounded down ====
+        // Branch-free over contiguous arrays, so the loop vectorizes
+        const double ratio = static_cast<double>(fillQty) / static_cast<double>(total);
+        Base::Quantity allocated = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Base::Quantity share = static_cast<Base::Quantity>(static_cast<double>(quantities[i]) * ratio);
+            share = std::min(share, quantities[i]);
+            allocations[i] = share;
+            allocated += share;
+        }
+
+        // ==== Undo double rounding that pushed a share one lot too high, newest orders first ====
+        while (allocated > fillQty)
+        {
+            for (size_t i = count; i-- > 0 && allocated > fillQty;)
+            {
+                if (allocations[i] > 0)
+                {
+                    --allocations[i];
+                    --allocated;
+                }
+            }
+        }
+
+        // ==== Hand out the leftover lots one at a time in time priority ====
+        while (allocated < fillQty)
+        {
+            for (size_t i = 0; i < count && allocated < fillQty; ++i)
+            {
+                if (allocations[i] < quantities[i])
+                {
+                    ++allocations[i];
+                    ++allocated;
+                }
+            }
+        }
+    }
+}
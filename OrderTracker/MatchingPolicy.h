@@ -0,0 +1,178 @@
+#pragma once
+#ifndef MATCHING_POLICY_H
+#define MATCHING_POLICY_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "PriceTracker.h"
+
+namespace OrderEngine
+{
+    /**
+     * @brief Allocation policies: how an incoming quantity is split across the orders of one level.
+     *
+     * @details
+     * - A policy is a template parameter of OrderBook, picked per product at compile time.
+     * - OrderTracker walks the levels that cross and hands each one to the policy:
+     *     Base::Quantity AllocateLevel(const PriceTracker<OrderPtr>& level, Base::Quantity maxQty,
+     *                                  std::vector<std::pair<OrderPtr, Base::Quantity>>& fills);
+     *   The policy appends (order, quantity) fills for that level and returns the total allocated.
+     * - void Reserve(size_t orders) sizes any scratch state for levels of up to that many orders,
+     *   so that matching against them does not allocate.
+     * - Fills are appended in time priority whatever the policy, so trades come out in queue order.
+     * - When maxQty covers the whole level, every policy takes every order in full.
+     */
+
+    /**
+     * @class FifoPolicy
+     * @brief Strict price-time priority.
+     * @details Stateless and fully inline, a FIFO book compiles to the same loop as before the
+     *          policy existed.
+     */
+    struct FifoPolicy
+    {
+        template<typename OrderPtr>
+        Base::Quantity AllocateLevel(const PriceTracker<OrderPtr>& level, Base::Quantity maxQty,
+                                     std::vector<std::pair<OrderPtr, Base::Quantity>>& fills)
+        {
+            const auto& orders = level.GetOrders();
+            Base::Quantity remaining = maxQty;
+
+            for (size_t slot = level.GetHead(); slot < orders.size() && remaining > 0; ++slot) {
+                const OrderPtr& order = orders[slot];
+                if (!order) continue; // removed order
+
+                Base::Quantity matchQty = std::min(order->GetOpenQuantity(), remaining);
+                fills.emplace_back(order, matchQty);
+                remaining -= matchQty;
+            }
+            return maxQty - remaining;
+        }
+
+        void Reserve(size_t) {}
+    };
+
+    /**
+     * @class ProRataPolicy
+     * @brief Splits a partial level fill in proportion to each order's open quantity.
+     *
+     * @details
+     * - Open quantities are gathered into a contiguous array once, the shares are then computed
+     *   in one branch-free pass over it (see Allocate) that the compiler can vectorize.
+     * - Rounding is deterministic: every order first gets its share rounded down, the lots left
+     *   over are handed out one at a time in time priority to orders with quantity to spare.
+     * - Orders whose share rounds to zero and that get no remainder lot receive no fill.
+     * - Scratch arrays are kept between calls, steady state matching does not allocate.
+     */
+    class ProRataPolicy
+    {
+    public:
+        template<typename OrderPtr>
+        Base::Quantity AllocateLevel(const PriceTracker<OrderPtr>& level, Base::Quantity maxQty,
+                                     std::vector<std::pair<OrderPtr, Base::Quantity>>& fills)
+        {
+            return AllocateExcluding(level, maxQty, fills, OrderPtr{});
+        }
+
+        // Pro-rata split over every live order of the level except exclude
+        template<typename OrderPtr>
+        Base::Quantity AllocateExcluding(const PriceTracker<OrderPtr>& level, Base::Quantity maxQty,
+                                         std::vector<std::pair<OrderPtr, Base::Quantity>>& fills,
+                                         const OrderPtr& exclude)
+        {
+            const auto& orders = level.GetOrders();
+
+            // ==== Gather open quantities into a contiguous array ====
+            mQuantities.clear();
+            Base::Quantity total = 0;
+            for (size_t slot = level.GetHead(); slot < orders.size(); ++slot) {
+                const OrderPtr& order = orders[slot];
+                if (!order || order == exclude) continue;
+                mQuantities.push_back(order->GetOpenQuantity());
+                total += order->GetOpenQuantity();
+            }
+
+            if (total == 0 || maxQty == 0) {
+                return 0;
+            }
+            if (maxQty >= total) {
+                maxQty = total; // Whole level, every order is filled in full
+            }
+
+            mAllocations.resize(mQuantities.size());
+            Allocate(mQuantities.data(), mQuantities.size(), total, maxQty, mAllocations.data());
+
+            // ==== Emit the non-zero allocations in time priority ====
+            size_t index = 0;
+            for (size_t slot = level.GetHead(); slot < orders.size(); ++slot) {
+                const OrderPtr& order = orders[slot];
+                if (!order || order == exclude) continue;
+                if (mAllocations[index] > 0) {
+                    fills.emplace_back(order, mAllocations[index]);
+                }
+                ++index;
+            }
+            return maxQty;
+        }
+
+        /**
+         * @brief Splits fillQty over count orders holding quantities[i], total being their sum.
+         * @details fillQty must not exceed total. The allocations always add up to fillQty exactly.
+         */
+        static void Allocate(const Base::Quantity* quantities, size_t count, Base::Quantity total,
+                             Base::Quantity fillQty, Base::Quantity* allocations);
+
+        void Reserve(size_t orders)
+        {
+            mQuantities.reserve(orders);
+            mAllocations.reserve(orders);
+        }
+
+    private:
+        std::vector<Base::Quantity> mQuantities;
+        std::vector<Base::Quantity> mAllocations;
+    };
+
+    /**
+     * @class TopOrderProRataPolicy
+     * @brief FIFO for the top order, pro-rata for the rest of the level.
+     *
+     * @details
+     * - The top order is the order that opened the level. While it rests, it is filled first,
+     *   in full if possible, as under FIFO.
+     * - Whatever is left is split pro-rata over the other orders of the level.
+     * - Once the top order is filled or cancelled the level has no top order, it is pure pro-rata.
+     */
+    class TopOrderProRataPolicy
+    {
+    public:
+        template<typename OrderPtr>
+        Base::Quantity AllocateLevel(const PriceTracker<OrderPtr>& level, Base::Quantity maxQty,
+                                     std::vector<std::pair<OrderPtr, Base::Quantity>>& fills)
+        {
+            OrderPtr topOrder = level.GetTopOrder();
+            if (!topOrder) {
+                return mProRata.AllocateLevel(level, maxQty, fills);
+            }
+
+            // The top order sits at the head of the queue, its fill comes first in time priority too
+            Base::Quantity topQty = std::min(topOrder->GetOpenQuantity(), maxQty);
+            fills.emplace_back(topOrder, topQty);
+            if (topQty == maxQty) {
+                return topQty;
+            }
+            return topQty + mProRata.AllocateExcluding(level, maxQty - topQty, fills, topOrder);
+        }
+
+        void Reserve(size_t orders)
+        {
+            mProRata.Reserve(orders);
+        }
+
+    private:
+        ProRataPolicy mProRata;
+    };
+}
+
+#endif // MATCHING_POLICY_H
@@ -0,0 +1,164 @@
+#pragma once
+#ifndef ORDER_LOCATION_INDEX_H
+#define ORDER_LOCATION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Memory/Arena.h"
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @class OrderLocationIndex
+     * @tparam Location Trivially copyable value stored per order id
+     * @brief Flat open-addressing map from order id to its location in the book.
+     *
+     * @details
+     * - One array of slots, linear probing on a Fibonacci hash of the id. Lookups touch one or
+     *   two cache lines, inserts and erases never allocate.
+     * - Erase shifts the following entries of the probe run back, so there are no tombstones
+     *   and the table never degrades under add/cancel churn.
+     * - Kept at most half full. Reserve sizes it up front; only an insert past that capacity
+     *   regrows the table, which is the one allocation it makes.
+     * - The slots come from the arena given at construction, the global heap if it is null.
+     * - Id kEmptyId marks a free slot and cannot be stored.
+     */
+    template<typename Location> class OrderLocationIndex
+    {
+    public:
+        static constexpr Base::OrderId kEmptyId = ~Base::OrderId{0};
+
+        explicit OrderLocationIndex(size_t reservedOrders = 0, Arena* arena = nullptr)
+            : mSlots(ArenaAllocator<Slot>(arena))
+        {
+            rehash(capacityFor(reservedOrders));
+        }
+
+        Location* Find(Base::OrderId orderId)
+        {
+            for (size_t i = home(orderId);; i = (i + 1) & mMask) {
+                Slot& slot = mSlots[i];
+                if (slot.mId == orderId) {
+                    return &slot.mLocation;
+                }
+                if (slot.mId == kEmptyId) {
+                    return nullptr;
+                }
+            }
+        }
+
+        const Location* Find(Base::OrderId orderId) const
+        {
+            return const_cast<OrderLocationIndex*>(this)->Find(orderId);
+        }
+
+        // False if the id is already indexed (or is kEmptyId)
+        bool Insert(Base::OrderId orderId, const Location& location)
+        {
+            if (orderId == kEmptyId) {
+                return false;
+            }
+            if ((mSize + 1) * 2 > mSlots.size()) {
+                rehash(mSlots.size() * 2);
+            }
+            size_t i = home(orderId);
+            for (; mSlots[i].mId != kEmptyId; i = (i + 1) & mMask) {
+                if (mSlots[i].mId == orderId) {
+                    return false;
+                }
+            }
+            mSlots[i] = {orderId, location};
+            ++mSize;
+            return true;
+        }
+
+        bool Erase(Base::OrderId orderId)
+        {
+            size_t hole = home(orderId);
+            for (; mSlots[hole].mId != orderId; hole = (hole + 1) & mMask) {
+                if (mSlots[hole].mId == kEmptyId) {
+                    return false;
+                }
+            }
+
+            // Pull back every later entry of the run that may not sit past the hole
+            for (size_t next = (hole + 1) & mMask; mSlots[next].mId != kEmptyId; next = (next + 1) & mMask) {
+                size_t wanted = home(mSlots[next].mId);
+                bool stays = hole <= next ? (hole < wanted && wanted <= next) : (hole < wanted || wanted <= next);
+                if (!stays) {
+                    mSlots[hole] = mSlots[next];
+                    hole = next;
+                }
+            }
+            mSlots[hole].mId = kEmptyId;
+            --mSize;
+            return true;
+        }
+
+        void Clear()
+        {
+            if (mSize == 0) {
+                return;
+            }
+            for (Slot& slot : mSlots) {
+                slot.mId = kEmptyId;
+            }
+            mSize = 0;
+        }
+
+        // Makes room for orders entries without regrowing
+        void Reserve(size_t orders)
+        {
+            if (capacityFor(orders) > mSlots.size()) {
+                rehash(capacityFor(orders));
+            }
+        }
+
+        size_t Size() const { return mSize; }
+        size_t GetCapacity() const { return mSlots.size() / 2; }
+
+    private:
+        struct Slot
+        {
+            Base::OrderId mId;
+            Location mLocation;
+        };
+
+        std::vector<Slot, ArenaAllocator<Slot>> mSlots;
+        size_t mMask = 0;
+        size_t mSize = 0;
+        unsigned mShift = 64;
+
+        static size_t capacityFor(size_t orders)
+        {
+            size_t slots = 16;
+            while (slots < orders * 2) {
+                slots *= 2;
+            }
+            return slots;
+        }
+
+        size_t home(Base::OrderId orderId) const
+        {
+            // Sequential ids spread over the whole table
+            return static_cast<size_t>((orderId * 0x9E3779B97F4A7C15ull) >> mShift);
+        }
+
+        void rehash(size_t slotCount)
+        {
+            std::vector<Slot, ArenaAllocator<Slot>> old(slotCount, Slot{kEmptyId, Location{}}, mSlots.get_allocator());
+            old.swap(mSlots);
+            mMask = slotCount - 1;
+            mShift = 64 - static_cast<unsigned>(__builtin_ctzll(slotCount));
+            mSize = 0;
+            for (const Slot& slot : old) {
+                if (slot.mId != kEmptyId) {
+                    Insert(slot.mId, slot.mLocation);
+                }
+            }
+        }
+    };
+} // namespace OrderEngine
+
+#endif //ORDER_LOCATION_INDEX_H
@@ -2,43 +2,51 @@
 
 namespace OrderEngine{
 
-    template <typename OrderPtr> OrderTracker<OrderPtr>::OrderTracker(bool isBuySide)
-        : mIsBuySide(isBuySide), mPriceTrackerMap(PriceComparator(isBuySide)) {}
+    template <typename OrderPtr, Base::OrderSide Side>
+    OrderTracker<OrderPtr, Side>::OrderTracker(PriceLevelPool<OrderPtr>& levelPool, size_t reservedOrders)
+        : mPriceTrackerMap(ArenaAllocator<typename PriceTrackerMap::value_type>(levelPool.GetArena())),
+          mOrderLocations(reservedOrders, levelPool.GetArena()),
+          mLevelPool(levelPool) {}
 
-    template<typename OrderPtr> void OrderTracker<OrderPtr>::
+    template <typename OrderPtr, Base::OrderSide Side> bool OrderTracker<OrderPtr, Side>::
     AddOrder(OrderPtr order)
     {
         if(!order)
         {
             // todo: log
-            return;
+            return false;
         }
 
         Base::OrderId orderId = order->GetId();
         Base::Price price = order->GetPrice();
 
         // Check if the order already exists.
-        if( mOrderLocationMap.find(orderId) != mOrderLocationMap.end() )
+        if( mOrderLocations.Find(orderId) )
         {   
             // Order already exsits
             // todo: log
-            return;
+            return false;
         }
 
         PriceTrackerPtr priceTracker = getOrCreatePriceTracker(price);
 
-        // Add order to the  PriceTracker and get the iterator
-        auto orderIterator = priceTracker->AddOrder(order);
+        // Add order to the  PriceTracker and get its handle
+        uint64_t levelHash = priceTracker->GetHash();
+        Base::Quantity levelQty = priceTracker->GetTotalQuantity();
+        auto orderHandle = priceTracker->AddOrder(order);
+        mHash += priceTracker->GetHash() - levelHash;
+        addTopQuantity(price, levelQty, priceTracker->GetTotalQuantity());
 
         // Cache the order's location
-        mOrderLocationMap[orderId] = std::make_pair(price,orderIterator);
+        mOrderLocations.Insert(orderId, std::make_pair(price,orderHandle));
 
-        std::cout<<"[INFO][OrderTracker][AddOrder]: Size of mOrderLocationMap= "<<mOrderLocationMap.size()<<std::endl;
+        ORDER_ENGINE_TRACE("[INFO][OrderTracker][AddOrder]: Size of mOrderLocations= "<<mOrderLocations.Size());
+        return true;
     }
 
-    template <typename OrderPtr> typename 
-    OrderTracker<OrderPtr>::PriceTrackerPtr
-    OrderTracker<OrderPtr>:: getOrCreatePriceTracker(Base::Price price)
+    template <typename OrderPtr, Base::OrderSide Side> typename 
+    OrderTracker<OrderPtr, Side>::PriceTrackerPtr
+    OrderTracker<OrderPtr, Side>:: getOrCreatePriceTracker(Base::Price price)
     {
         // Finding existing PriceTracker
         auto it = mPriceTrackerMap.find(price);
@@ -47,24 +55,24 @@ namespace OrderEngine{
         if (it != mPriceTrackerMap.end()) 
         {
             // Found the PriceTracker in map
-            std::cout<<"[INFO][OrderTracker][getOrCreatePriceTracker]: PriceTracker already exsits.  "<<std::endl;
+            ORDER_ENGINE_TRACE("[INFO][OrderTracker][getOrCreatePriceTracker]: PriceTracker already exsits.  ");
             return it->second;
         }
 
-        std::cout<<"[INFO][OrderTracker][getOrCreatePriceTracker]: PriceTracker created.  "<<std::endl;
+        ORDER_ENGINE_TRACE("[INFO][OrderTracker][getOrCreatePriceTracker]: PriceTracker created.  ");
 
-        // Not able to find PriceTracker, creating a new one
-        auto newPriceTracker = std::make_shared<PriceTracker<OrderPtr>>(price);
+        // Not able to find PriceTracker, taking a recycled one from the pool
+        PriceTrackerPtr newPriceTracker = mLevelPool.Acquire(price);
         
         // Storing the newly created PriceTracker in map
-        mPriceTrackerMap[price] = newPriceTracker;
-        
+        onLevelInserted(mPriceTrackerMap.emplace(price, newPriceTracker).first);
+
         return newPriceTracker;
     }
 
 
-    template <typename OrderPtr>
-    void OrderTracker<OrderPtr>::RemoveOrder(OrderPtr order)
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::RemoveOrder(OrderPtr order)
     {
         if (!order)
         {
@@ -74,17 +82,17 @@ namespace OrderEngine{
 
         Base::OrderId orderId = order->GetId();
         // Find the order's location in the cache
-        auto locationIt = mOrderLocationMap.find(orderId);
+        const OrderLocation* location = mOrderLocations.Find(orderId);
 
-        if (locationIt == mOrderLocationMap.end())
+        if (!location)
         {
             // Order not found in tracker
             // todo: log warning - trying to remove a non-existent order
             return;
         }
-        // Extract price and order iterator from the cached location
-        Base::Price price = locationIt->second.first;
-        auto orderIterator = locationIt->second.second;
+        // Extract price and order handle from the cached location
+        Base::Price price = location->first;
+        auto orderHandle = location->second;
 
         // Find the PriceTracker at this price level
         auto priceTrackerIt = mPriceTrackerMap.find(price);
@@ -93,29 +101,34 @@ namespace OrderEngine{
         {
             // Price level not found (should never happen if cache is consistent)
             // todo: log error - inconsistent state
-            mOrderLocationMap.erase(locationIt);
+            mOrderLocations.Erase(orderId);
             return;
         }
 
         PriceTrackerPtr priceTracker = priceTrackerIt->second;
 
         // Remove the order from the PriceTracker's order list
-        priceTracker->RemoveOrder(orderIterator);
+        uint64_t levelHash = priceTracker->GetHash();
+        Base::Quantity levelQty = priceTracker->GetTotalQuantity();
+        priceTracker->RemoveOrder(orderHandle);
+        mHash += priceTracker->GetHash() - levelHash;
+        addTopQuantity(price, levelQty, priceTracker->GetTotalQuantity());
 
         // Remove from location cache
-        mOrderLocationMap.erase(locationIt);
+        mOrderLocations.Erase(orderId);
 
         // 
         if (priceTracker->IsEmpty())
         {
-            mPriceTrackerMap.erase(priceTrackerIt);
+            releaseLevel(priceTrackerIt);
         }
     }
 
-    template <typename OrderPtr>
-    std::vector<std::pair<OrderPtr, Base::Quantity>> OrderTracker<OrderPtr>::MatchQuantity(Base::Price limitPrice, Base::Quantity maxQty)
+    template <typename OrderPtr, Base::OrderSide Side>
+    template <typename MatchingPolicy>
+    void OrderTracker<OrderPtr, Side>::MatchQuantity(Base::Price limitPrice, Base::Quantity maxQty, MatchingPolicy& policy,
+                                                     Fills& matches)
     {
-        std::vector<std::pair<OrderPtr, Base::Quantity>> matches;
         Base::Quantity remaining = maxQty;
 
         auto it = mPriceTrackerMap.begin();
@@ -123,33 +136,16 @@ namespace OrderEngine{
             Base::Price level_price = it->first;
 
             // Check if this price level can match
-            bool can_match = mIsBuySide ? (level_price >= limitPrice) : (level_price <= limitPrice);
-            if (!can_match) break;
-
-            auto level = it->second;
-            auto& orders = level->GetOrders();
-            auto order_it = orders.begin();
-
-            while (order_it != orders.end() && remaining > 0) {
-                auto order = *order_it;
-                Base::Quantity available = order->GetOpenQuantity();
-                Base::Quantity matchQty = std::min(available, remaining);
-
-                matches.emplace_back(order, matchQty);
-                remaining -= matchQty;
-
-                ++order_it;
-            }
+            if (!CanMatch(level_price, limitPrice)) break;
 
+            remaining -= policy.AllocateLevel(*it->second, remaining, matches);
             ++it;
         }
-
-        return matches;
     }
 
 
-    template <typename OrderPtr>
-    void OrderTracker<OrderPtr>::UpdateOrderQuantity(OrderPtr order, Base::Quantity newQty)
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::UpdateOrderQuantity(OrderPtr order, Base::Quantity newQty)
     {
         if (!order) {
             // todo: log error
@@ -158,17 +154,17 @@ namespace OrderEngine{
 
         Base::OrderId orderId = order->GetId();
         // Find the order's location in the cache
-        auto locationIt = mOrderLocationMap.find(orderId);
+        const OrderLocation* location = mOrderLocations.Find(orderId);
 
-        if (locationIt == mOrderLocationMap.end()) {
+        if (!location) {
             // Order not found in tracker
             // todo: log warning - trying to update non-existent order
             return;
         }
 
-        // Extract price and order iterator from the cached location
-        Base::Price price = locationIt->second.first;
-        auto orderIterator = locationIt->second.second;
+        // Extract price and order handle from the cached location
+        Base::Price price = location->first;
+        auto orderHandle = location->second;
 
         // Find the PriceTracker at this price level
         auto priceTrackerIt = mPriceTrackerMap.find(price);
@@ -176,36 +172,343 @@ namespace OrderEngine{
         if (priceTrackerIt == mPriceTrackerMap.end()) {
             // Price level not found (should never happen if cache is consistent)
             // todo: log error - inconsistent state
-            mOrderLocationMap.erase(locationIt);
+            mOrderLocations.Erase(orderId);
             return;
         }   
 
         PriceTrackerPtr priceTracker = priceTrackerIt->second;
-
-        // Update the order's quantity
-        order->SetOpenQuantity(newQty);
+        uint64_t levelHash = priceTracker->GetHash();
+        Base::Quantity levelQty = priceTracker->GetTotalQuantity();
 
         if (newQty == 0) {
-            // Remove from PriceTracker
-            priceTracker->RemoveOrder(orderIterator);
+            // Remove from PriceTracker, this takes the order's open quantity off the level total
+            priceTracker->RemoveOrder(orderHandle);
+            mHash += priceTracker->GetHash() - levelHash;
+            addTopQuantity(price, levelQty, priceTracker->GetTotalQuantity());
+            order->SetOpenQuantity(newQty);
             
             // Remove from location cache
-            mOrderLocationMap.erase(locationIt);
+            mOrderLocations.Erase(orderId);
             
             // If PriceTracker is now empty, remove it from the map
             if (priceTracker->IsEmpty()) {
-                mPriceTrackerMap.erase(priceTrackerIt);
+                releaseLevel(priceTrackerIt);
             }
             
-            std::cout << "[INFO][OrderTracker][UpdateOrderQuantity]: Order " << orderId 
-                    << " removed (qty=0)" << std::endl;
+            ORDER_ENGINE_TRACE("[INFO][OrderTracker][UpdateOrderQuantity]: Order " << orderId 
+                    << " removed (qty=0)");
         } 
         else {
-            // Just log the update
-            std::cout << "[INFO][OrderTracker][UpdateOrderQuantity]: Order " << orderId 
-                    << " updated to qty=" << newQty << std::endl;
+            // Keep the level total in step with the order's open quantity
+            priceTracker->UpdateQuantity(orderHandle, order->GetOpenQuantity(), newQty);
+            mHash += priceTracker->GetHash() - levelHash;
+            addTopQuantity(price, levelQty, priceTracker->GetTotalQuantity());
+            order->SetOpenQuantity(newQty);
+
+            ORDER_ENGINE_TRACE("[INFO][OrderTracker][UpdateOrderQuantity]: Order " << orderId 
+                    << " updated to qty=" << newQty);
+        }
+    }
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::ApplyFills(const Fills& fills)
+    {
+        // Fills arrive level by level in priority order, so the level lookup is reused across a level
+        auto priceTrackerIt = mPriceTrackerMap.end();
+
+        for (const auto& [order, fillQty] : fills) {
+            const OrderLocation* location = mOrderLocations.Find(order->GetId());
+            if (!location) {
+                // todo: log warning - fill for an order that is not in the tracker
+                continue;
+            }
+
+            const auto [price, orderHandle] = *location;
+            if (priceTrackerIt == mPriceTrackerMap.end() || priceTrackerIt->first != price) {
+                priceTrackerIt = mPriceTrackerMap.find(price);
+            }
+            PriceTrackerPtr priceTracker = priceTrackerIt->second;
+
+            Base::Quantity openQty = order->GetOpenQuantity();
+            Base::Quantity newQty = openQty - std::min(openQty, fillQty);
+            uint64_t levelHash = priceTracker->GetHash();
+            Base::Quantity levelQty = priceTracker->GetTotalQuantity();
+
+            if (newQty == 0) {
+                priceTracker->RemoveOrder(orderHandle);
+                mOrderLocations.Erase(order->GetId());
+            }
+            else {
+                priceTracker->UpdateQuantity(orderHandle, openQty, newQty);
+            }
+            mHash += priceTracker->GetHash() - levelHash;
+            addTopQuantity(price, levelQty, priceTracker->GetTotalQuantity());
+            order->SetOpenQuantity(newQty);
+
+            if (priceTracker->IsEmpty()) {
+                releaseLevel(priceTrackerIt);
+                priceTrackerIt = mPriceTrackerMap.end();
+            }
+        }
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::GetLevels(Base::Price limitPrice, std::vector<Base::LevelInfo>& levels) const
+    {
+        for (auto it = mPriceTrackerMap.begin(); it != mPriceTrackerMap.end(); ++it) {
+            if (!CanMatch(it->first, limitPrice)) break;
+            levels.push_back({it->first, it->second->GetTotalQuantity(), it->second->GetOrderCount()});
+        }
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    size_t OrderTracker<OrderPtr, Side>::GetTopLevels(Base::LevelInfo* levels, size_t maxLevels) const
+    {
+        size_t count = 0;
+        for (auto it = mPriceTrackerMap.begin(); it != mPriceTrackerMap.end() && count < maxLevels; ++it, ++count) {
+            levels[count] = {it->first, it->second->GetTotalQuantity(), it->second->GetOrderCount()};
+        }
+        return count;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    uint64_t OrderTracker<OrderPtr, Side>::GetHash() const
+    {
+        return mHash;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    uint64_t OrderTracker<OrderPtr, Side>::GetLevelHash(Base::Price price) const
+    {
+        auto priceTrackerIt = mPriceTrackerMap.find(price);
+        return priceTrackerIt == mPriceTrackerMap.end() ? 0 : priceTrackerIt->second->GetHash();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    bool OrderTracker<OrderPtr, Side>::IsEmpty() const
+    {
+        return mPriceTrackerMap.empty();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    Base::Price OrderTracker<OrderPtr, Side>::GetBestPrice() const
+    {
+        return mPriceTrackerMap.empty() ? 0 : mPriceTrackerMap.begin()->first;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    Base::Quantity OrderTracker<OrderPtr, Side>::GetBestQuantity() const
+    {
+        return mPriceTrackerMap.empty() ? 0 : mPriceTrackerMap.begin()->second->GetTotalQuantity();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    Base::Quantity OrderTracker<OrderPtr, Side>::GetTopQuantity() const
+    {
+        return mTopQuantity;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::SetTopDepth(size_t levels)
+    {
+        mTopDepth = levels;
+        resetTop();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    size_t OrderTracker<OrderPtr, Side>::GetTopDepth() const
+    {
+        return mTopDepth;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    OrderPtr OrderTracker<OrderPtr, Side>::FindOrder(Base::OrderId orderId) const
+    {
+        const OrderLocation* location = mOrderLocations.Find(orderId);
+        if (!location) {
+            return nullptr;
+        }
+
+        auto priceTrackerIt = mPriceTrackerMap.find(location->first);
+        if (priceTrackerIt == mPriceTrackerMap.end()) {
+            return nullptr;
         }
+        return priceTrackerIt->second->GetOrder(location->second);
     }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    bool OrderTracker<OrderPtr, Side>::GetQueuePosition(Base::OrderId orderId, Base::QueuePosition& position) const
+    {
+        const OrderLocation* location = mOrderLocations.Find(orderId);
+        if (!location) {
+            return false;
+        }
+
+        auto priceTrackerIt = mPriceTrackerMap.find(location->first);
+        if (priceTrackerIt == mPriceTrackerMap.end()) {
+            return false;
+        }
+        return priceTrackerIt->second->GetQueuePosition(location->second, position);
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    Base::Quantity OrderTracker<OrderPtr, Side>::SweepBestLevel(Base::Price limitPrice, Base::Quantity maxQty, std::vector<OrderPtr>& swept)
+    {
+        auto levelIt = mPriceTrackerMap.begin();
+        if (levelIt == mPriceTrackerMap.end() || !CanMatch(levelIt->first, limitPrice)) {
+            return 0;
+        }
+
+        const PriceTracker<OrderPtr>& level = *levelIt->second;
+        Base::Quantity levelQty = level.GetTotalQuantity();
+        if (levelQty > maxQty) {
+            return 0;
+        }
+
+        size_t first = swept.size();
+        collectOrders(level, swept);
+        for (size_t i = first; i < swept.size(); ++i) {
+            mOrderLocations.Erase(swept[i]->GetId());
+        }
+        mHash -= level.GetHash();
+        releaseLevel(levelIt);
+        return levelQty;
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::RemoveAll(std::vector<OrderPtr>& removed)
+    {
+        for (const auto& [price, priceTracker] : mPriceTrackerMap) {
+            collectOrders(*priceTracker, removed);
+            mLevelPool.Release(priceTracker);
+        }
+
+        // Nothing is left on this side, so both indexes are cleared wholesale
+        mPriceTrackerMap.clear();
+        mOrderLocations.Clear();
+        mHash = 0;
+        resetTop();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::RemoveLevels(Base::Price lowPrice, Base::Price highPrice, std::vector<OrderPtr>& removed)
+    {
+        if (lowPrice > highPrice) {
+            return;
+        }
+
+        // Map order is best price first: descending for bids, ascending for asks
+        auto first = mPriceTrackerMap.lower_bound(kIsBuySide ? highPrice : lowPrice);
+        auto last = mPriceTrackerMap.upper_bound(kIsBuySide ? lowPrice : highPrice);
+
+        size_t firstRemoved = removed.size();
+        for (auto it = first; it != last; ++it) {
+            collectOrders(*it->second, removed);
+            mHash -= it->second->GetHash();
+            mLevelPool.Release(it->second);
+        }
+
+        for (size_t i = firstRemoved; i < removed.size(); ++i) {
+            mOrderLocations.Erase(removed[i]->GetId());
+        }
+        mPriceTrackerMap.erase(first, last);
+        // A bulk removal, the top levels are summed again rather than tracked through it
+        resetTop();
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::releaseLevel(LevelIterator levelIt)
+    {
+        onLevelErasing(levelIt);
+        mLevelPool.Release(levelIt->second);
+        mPriceTrackerMap.erase(levelIt);
+    }
+
+    // At or better than the last summed level, which is then one of the top levels
+    template <typename OrderPtr, Base::OrderSide Side>
+    bool OrderTracker<OrderPtr, Side>::isTopLevel(Base::Price price) const
+    {
+        return mTopCount != 0 && !PriceComparator{}(mTopLast->first, price);
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::addTopQuantity(Base::Price price, Base::Quantity before, Base::Quantity after)
+    {
+        if (isTopLevel(price)) {
+            mTopQuantity += after - before; // Wraps back to the right sum when the level shrank
+        }
+    }
+
+    /**
+     * @brief A level just entered the map. Levels are created empty, only the level count moves:
+     *        inside the top N it pushes the last summed level out, while the top is not full it joins.
+     */
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::onLevelInserted(LevelIterator levelIt)
+    {
+        if (mTopCount < mTopDepth) {
+            if (mTopCount == 0 || PriceComparator{}(mTopLast->first, levelIt->first)) {
+                mTopLast = levelIt;
+            }
+            ++mTopCount;
+        }
+        else if (mTopCount != 0 && PriceComparator{}(levelIt->first, mTopLast->first)) {
+            mTopQuantity -= mTopLast->second->GetTotalQuantity();
+            --mTopLast;
+        }
+    }
+
+    // A summed level is about to leave the map, the first level below the top moves up to replace it
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::onLevelErasing(LevelIterator levelIt)
+    {
+        if (!isTopLevel(levelIt->first)) {
+            return;
+        }
+        mTopQuantity -= levelIt->second->GetTotalQuantity();
+
+        auto next = std::next(mTopLast);
+        if (next != mPriceTrackerMap.end()) {
+            mTopQuantity += next->second->GetTotalQuantity();
+            mTopLast = next;
+        }
+        else if (--mTopCount != 0 && levelIt == mTopLast) {
+            --mTopLast;
+        }
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::resetTop()
+    {
+        mTopQuantity = 0;
+        mTopCount = 0;
+        for (auto it = mPriceTrackerMap.begin(); it != mPriceTrackerMap.end() && mTopCount < mTopDepth; ++it) {
+            mTopQuantity += it->second->GetTotalQuantity();
+            mTopLast = it;
+            ++mTopCount;
+        }
+    }
+
+    template <typename OrderPtr, Base::OrderSide Side>
+    void OrderTracker<OrderPtr, Side>::collectOrders(const PriceTracker<OrderPtr>& level, std::vector<OrderPtr>& out)
+    {
+        const auto& orders = level.GetOrders();
+        for (size_t slot = level.GetHead(); slot < orders.size(); ++slot) {
+            if (orders[slot]) {
+                out.push_back(orders[slot]);
+            }
+        }
+    }
+
     // Explicit template instantiation
-    template class OrderTracker<Order*>;
+    template class OrderTracker<Order*, Base::OrderSide::BUY>;
+    template class OrderTracker<Order*, Base::OrderSide::SELL>;
+
+    // One MatchQuantity per allocation policy a book can be built with
+    using Fills = std::vector<std::pair<Order*, Base::Quantity>>;
+    template void OrderTracker<Order*, Base::OrderSide::BUY>::MatchQuantity(Base::Price, Base::Quantity, FifoPolicy&, Fills&);
+    template void OrderTracker<Order*, Base::OrderSide::SELL>::MatchQuantity(Base::Price, Base::Quantity, FifoPolicy&, Fills&);
+    template void OrderTracker<Order*, Base::OrderSide::BUY>::MatchQuantity(Base::Price, Base::Quantity, ProRataPolicy&, Fills&);
+    template void OrderTracker<Order*, Base::OrderSide::SELL>::MatchQuantity(Base::Price, Base::Quantity, ProRataPolicy&, Fills&);
+    template void OrderTracker<Order*, Base::OrderSide::BUY>::MatchQuantity(Base::Price, Base::Quantity, TopOrderProRataPolicy&, Fills&);
+    template void OrderTracker<Order*, Base::OrderSide::SELL>::MatchQuantity(Base::Price, Base::Quantity, TopOrderProRataPolicy&, Fills&);
 } // namespace OrderEngine
\ No newline at end of file
@@ -10,13 +10,18 @@
 #include <atomic>
 #include <mutex>
 #include "PriceTracker.h"
+#include "PriceLevelPool.h"
+#include "OrderLocationIndex.h"
+#include "MatchingPolicy.h"
 #include "../Order.h"
+#include "../Log.h"
 
 namespace OrderEngine{
 
     /**
      * @class OrderTracker 
      * @typedef OrderPtr
+     * @tparam Side Side of the book this tracker holds, fixed at compile time
      * @brief Manages one side of the order book (all buys/all sells)
      * 
      * @details
@@ -27,10 +32,13 @@ namespace OrderEngine{
      * - Supports order matching again incoming trades, and provides quick
      *   access to the best price levels.
      */
-    template<typename OrderPtr> class OrderTracker
+    template<typename OrderPtr, Base::OrderSide Side> class OrderTracker
     {
     public:
-    using PriceTrackerPtr = std::shared_ptr<PriceTracker<OrderPtr> >;
+    // Levels are owned by the book's PriceLevelPool, the tracker only references them
+    using PriceTrackerPtr = PriceTracker<OrderPtr>*;
+
+        static constexpr bool kIsBuySide = Side == Base::OrderSide::BUY;
 
         /**
         * @brief Custom comparator for price-based map ordering
@@ -39,58 +47,166 @@ namespace OrderEngine{
         * Sell side: Lower prices have priority (ascending order)
         */
         struct PriceComparator{
-            bool mIsBuySide;
-            
-            explicit PriceComparator(bool isBuySide = false) 
-                : mIsBuySide(isBuySide) {}
-
-            bool operator()(Base::Price a, Base::Price b) const {
-                return mIsBuySide ? a > b : a < b;  
+            constexpr bool operator()(Base::Price a, Base::Price b) const {
+                if constexpr (kIsBuySide) {
+                    return a > b;
+                }
+                else {
+                    return a < b;
+                }
             }
         }; // struct PriceComparator
 
+        /**
+         * @brief Price-crossing predicate: can a resting level at levelPrice trade against limitPrice?
+         *
+         * Buy side: level must be at or above the incoming sell limit
+         * Sell side: level must be at or below the incoming buy limit
+         */
+        static constexpr bool CanMatch(Base::Price levelPrice, Base::Price limitPrice) {
+            return !PriceComparator{}(limitPrice, levelPrice);
+        }
+
         /**
          * Example:
          * - mPriceTrackerMap[15100] = PriceTracker containing [Order A, Order B, Order C]  // 151.00
          * - mPriceTrackerMap[15050] = PriceTracker containing [Order D, Order E]           // 150.50  
          * - mPriceTrackerMap[15000] = PriceTracker containing [Order F]                    // 150.00
         */
-    using PriceTrackerMap = std::map<Base::Price, PriceTrackerPtr, PriceComparator>;
+    using PriceTrackerMap = std::map<Base::Price, PriceTrackerPtr, PriceComparator,
+                                     ArenaAllocator<std::pair<const Base::Price, PriceTrackerPtr>>>;
         
         /**
          * Cache for efficient order lookups
          * Location of order in the order book
          * - Key: OrderId
-         * - Value: Pair of (Price, Iterator to order in PriceTracker's OrderList
+         * - Value: Pair of (Price, Handle of order in PriceTracker's OrderList)
          * 
          * Example:
-         * - mOrderLocationMap[12345] = (15100, Iterator to Order A in PriceTracker at 15100)
-         * - mOrderLocationMap[12346] = (15100, Iterator to Order B in PriceTracker at 15100)
+         * - mOrderLocations[12345] = (15100, Handle of Order A in PriceTracker at 15100)
+         * - mOrderLocations[12346] = (15100, Handle of Order B in PriceTracker at 15100)
          */
-        using OrderLocationMap = 
-            std::map<Base::OrderId, 
-               std::pair<Base::Price, typename PriceTracker<OrderPtr>::OrderIterator>>;
+        using OrderLocation = std::pair<Base::Price, typename PriceTracker<OrderPtr>::OrderHandle>;
+        using OrderLocationMap = OrderLocationIndex<OrderLocation>;
+        using Fills = std::vector<std::pair<OrderPtr, Base::Quantity>>;
         
-        // Constructor
-        explicit OrderTracker(bool isBuySide); 
+        // Constructor, the map and the index allocate from the pool's arena, the index is sized for reservedOrders
+        explicit OrderTracker(PriceLevelPool<OrderPtr>& levelPool, size_t reservedOrders = 0);
         
-        // Add an order to the tracker
-        void AddOrder(OrderPtr order);
+        // Add an order to the tracker, false (and nothing added) for a null order or an id already tracked
+        bool AddOrder(OrderPtr order);
+
+        /**
+         * @brief Allocates up to maxQty over the levels that can trade at limitPrice, best price first.
+         * @details
+         * - Within a level the quantity is split by the policy (see MatchingPolicy.h).
+         * - Fills are appended to matches, a scratch vector the caller reuses so matching does not allocate.
+         */
+        template<typename MatchingPolicy>
+        void MatchQuantity(Base::Price limitPrice, Base::Quantity maxQty, MatchingPolicy& policy, Fills& matches);
+
+        /**
+         * @brief Takes the whole best level if it can trade at limitPrice and maxQty covers all of it.
+         * @details
+         * - The level's orders are appended to swept in time priority, their location entries are
+         *   erased in one pass and the level goes back to the pool in one step.
+         * - Open quantities and statuses of the swept orders are left to the caller.
+         * @return Quantity of the swept level, 0 if the best level was not taken
+         */
+        Base::Quantity SweepBestLevel(Base::Price limitPrice, Base::Quantity maxQty, std::vector<OrderPtr>& swept);
+
+        /**
+         * @brief Applies a batch of fills produced by MatchQuantity in one pass.
+         * @details
+         * - Reduces each order's open quantity, removes fully filled orders and
+         *   drops levels that become empty.
+         * - Order statuses are left to the caller.
+         */
+        void ApplyFills(const Fills& fills);
+
+        /**
+         * @brief Collects the levels that can trade at limitPrice, best price first.
+         */
+        void GetLevels(Base::Price limitPrice, std::vector<Base::LevelInfo>& levels) const;
 
-        std::vector<std::pair<OrderPtr, Base::Quantity>> MatchQuantity(Base::Price limitPrice, Base::Quantity maxQty);
+        /**
+         * @brief Copies up to maxLevels best levels into levels, returns how many were written.
+         */
+        size_t GetTopLevels(Base::LevelInfo* levels, size_t maxLevels) const;
 
         void UpdateOrderQuantity(OrderPtr order, Base::Quantity newQty);
         void RemoveOrder(OrderPtr order);
+
+        // Resting order with this id, nullptr if the tracker does not hold it
+        OrderPtr FindOrder(Base::OrderId orderId) const;
+
+        // Orders and quantity ahead of a resting order in its level, false if the tracker does not hold it
+        bool GetQueuePosition(Base::OrderId orderId, Base::QueuePosition& position) const;
+
+        /**
+         * @brief Drops every level at once.
+         * @details Removed orders are appended to removed, their open quantity is left as is.
+         */
+        void RemoveAll(std::vector<OrderPtr>& removed);
+
+        /**
+         * @brief Drops all levels priced within [lowPrice, highPrice] in one range erase.
+         * @details Removed orders are appended to removed, their open quantity is left as is.
+         */
+        void RemoveLevels(Base::Price lowPrice, Base::Price highPrice, std::vector<OrderPtr>& removed);
+
+        /**
+         * @brief Rolling hash of this side: the wrapping sum of every level's hash.
+         * @details Kept current in O(1) by every mutation above, nothing is walked to read it.
+         */
+        uint64_t GetHash() const;
+
+        // Hash of the level at price, 0 if there is none; narrows a side mismatch down to its levels
+        uint64_t GetLevelHash(Base::Price price) const;
+
+        /**
+         * @brief Open quantity of the best GetTopDepth() levels of this side.
+         * @details Kept current like the hash: a quantity change inside those levels adjusts the sum,
+         *          a level entering or leaving them swaps one level in or out. Reading it is O(1).
+         */
+        Base::Quantity GetTopQuantity() const;
+
+        // Number of levels GetTopQuantity covers, changing it re-sums that many levels
+        void SetTopDepth(size_t levels);
+        size_t GetTopDepth() const;
+
+        bool IsEmpty() const;
+        Base::Price GetBestPrice() const;
+        // Open quantity of the best level, 0 if the side is empty
+        Base::Quantity GetBestQuantity() const;
     private:
+        using LevelIterator = typename PriceTrackerMap::iterator;
+
         PriceTrackerMap mPriceTrackerMap;
-        OrderLocationMap mOrderLocationMap;
-        bool mIsBuySide; // True if this tracker is for buy orders, false for sell orders
+        OrderLocationMap mOrderLocations;
+        PriceLevelPool<OrderPtr>& mLevelPool;
+        uint64_t mHash = 0; // Sum of the level hashes
+
+        // Top-N quantity: levels [begin, mTopLast] are summed, mTopCount of them
+        size_t mTopDepth = 5;
+        size_t mTopCount = 0;
+        LevelIterator mTopLast;
+        Base::Quantity mTopQuantity = 0;
 
         PriceTrackerPtr getOrCreatePriceTracker(Base::Price price);
+        void releaseLevel(LevelIterator levelIt);
+
+        bool isTopLevel(Base::Price price) const;
+        void addTopQuantity(Base::Price price, Base::Quantity before, Base::Quantity after);
+        void onLevelInserted(LevelIterator levelIt);
+        void onLevelErasing(LevelIterator levelIt);
+        void resetTop();
+        static void collectOrders(const PriceTracker<OrderPtr>& level, std::vector<OrderPtr>& out);
     };
 
     // Explicit template instantiation declaration
-    extern template class OrderTracker<Order*>;
+    extern template class OrderTracker<Order*, Base::OrderSide::BUY>;
+    extern template class OrderTracker<Order*, Base::OrderSide::SELL>;
 
 } // namespace OrderEngine
 #endif // ORDER_TRACKER_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "PriceLevelPool.h"
+#include "../Order.h"
+
+namespace OrderEngine
+{
+    template <typename OrderPtr> PriceLevelPool<OrderPtr>::PriceLevelPool(size_t reservedLevels, Arena* arena,
+                                                                          size_t ordersPerLevel)
+        : mArena(arena),
+          mOrdersPerLevel(ordersPerLevel),
+          mLevels(ArenaAllocator<PriceTracker<OrderPtr>>(arena)),
+          mFreeLevels(ArenaAllocator<PriceTracker<OrderPtr>*>(arena))
+    {
+        mFreeLevels.reserve(reservedLevels);
+        for (size_t i = 0; i < reservedLevels; ++i)
+        {
+            mFreeLevels.push_back(createLevel(0));
+        }
+    }
+
+    template <typename OrderPtr> PriceTracker<OrderPtr>* PriceLevelPool<OrderPtr>::
+    Acquire(Base::Price price)
+    {
+        if (mFreeLevels.empty())
+        {
+            // Pool exhausted, grow it by one level. The free list grows with it, Release never allocates
+            PriceTracker<OrderPtr>* level = createLevel(price);
+            if (mFreeLevels.capacity() < mLevels.size()) {
+                mFreeLevels.reserve(mLevels.size() * 2);
+            }
+            return level;
+        }
+
+        PriceTracker<OrderPtr>* level = mFreeLevels.back();
+        mFreeLevels.pop_back();
+        level->Reset(price);
+        return level;
+    }
+
+    template <typename OrderPtr> void PriceLevelPool<OrderPtr>::
+    Release(PriceTracker<OrderPtr>* level)
+    {
+        mFreeLevels.push_back(level);
+    }
+
+    template <typename OrderPtr> PriceTracker<OrderPtr>* PriceLevelPool<OrderPtr>::
+    createLevel(Base::Price price)
+    {
+        PriceTracker<OrderPtr>& level = mLevels.emplace_back(price, mArena);
+        level.Reserve(mOrdersPerLevel);
+        return &level;
+    }
+
+    template <typename OrderPtr> size_t PriceLevelPool<OrderPtr>::
+    GetLevelsInUse() const
+    {
+        return mLevels.size() - mFreeLevels.size();
+    }
+
+    template <typename OrderPtr> size_t PriceLevelPool<OrderPtr>::
+    GetLevelsFree() const
+    {
+        return mFreeLevels.size();
+    }
+
+    template <typename OrderPtr> size_t PriceLevelPool<OrderPtr>::
+    GetCapacity() const
+    {
+        return mLevels.size();
+    }
+
+    template <typename OrderPtr> Arena* PriceLevelPool<OrderPtr>::
+    GetArena() const
+    {
+        return mArena;
+    }
+
+    template class PriceLevelPool<Order*>;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef PRICE_LEVEL_POOL_H
+#define PRICE_LEVEL_POOL_H
+
+#include <deque>
+#include <vector>
+#include "PriceTracker.h"
+
+namespace OrderEngine
+{
+    /**
+     * @class PriceLevelPool
+     * @brief Recycles PriceTracker objects for the levels of an order book.
+     *
+     * @details
+     * - Levels near the touch appear and disappear constantly. Instead of a heap allocation
+     *   per new level, the book takes a level from the pool and hands it back once it empties.
+     * - A released level keeps its order queue buffer, so the next price that reuses it
+     *   does not allocate either.
+     * - Levels live in a deque, their addresses never change and the trackers hold plain pointers.
+     * - One pool is owned by the book and shared by all of its trackers.
+     * - Levels, their queues and the trackers' maps are allocated from the pool's arena.
+     * - Every level gets room for ordersPerLevel queued orders when it is created, so a level
+     *   only regrows its queue once it holds more than that.
+     */
+    template<typename OrderPtr> class PriceLevelPool
+    {
+    public:
+        explicit PriceLevelPool(size_t reservedLevels = 0, Arena* arena = nullptr, size_t ordersPerLevel = 0);
+
+        PriceTracker<OrderPtr>* Acquire(Base::Price price);
+        void Release(PriceTracker<OrderPtr>* level);
+
+        size_t GetLevelsInUse() const;
+        size_t GetLevelsFree() const;
+        size_t GetCapacity() const;
+        Arena* GetArena() const;
+
+    private:
+        Arena* mArena;
+        size_t mOrdersPerLevel;
+        std::deque<PriceTracker<OrderPtr>, ArenaAllocator<PriceTracker<OrderPtr>>> mLevels;
+        std::vector<PriceTracker<OrderPtr>*, ArenaAllocator<PriceTracker<OrderPtr>*>> mFreeLevels;
+
+        PriceTracker<OrderPtr>* createLevel(Base::Price price);
+    };
+
+    class Order; // forward declare
+    extern template class PriceLevelPool<Order*>;
+}
+
+#endif // PRICE_LEVEL_POOL_H
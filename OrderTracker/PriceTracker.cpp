@@ -1,11 +1,39 @@
 #include "PriceTracker.h"
-#include "../Order.h" 
+#include "../Order.h"
+
+#include <cstdint>
 
 namespace OrderEngine
 {
+    // Compaction kicks in once this many dead slots sit in front of the queue
+    static constexpr size_t kCompactThreshold = 32;
+    // No live order there: past either end of the queue
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+    template <typename OrderPtr> PriceTracker<OrderPtr>::PriceTracker(Base::Price price, Arena* arena)
+        : mPrice(price), mOrders(ArenaAllocator<OrderPtr>(arena)), mQueueTree(ArenaAllocator<QueueWeight>(arena)),
+          mTotalQuantity(0), mOrderCount(0) {}
 
-    template <typename OrderPtr> PriceTracker<OrderPtr>::PriceTracker(Base::Price price)
-        : mPrice(price), mTotalQuantity(0), mOrderCount(0) {}
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    Reset(Base::Price price)
+    {
+        mPrice = price;
+        mBaseSequence += mOrders.size();
+        mTopSequence = mBaseSequence;
+        mOrders.clear(); // keeps capacity
+        mQueueTree.clear();
+        mHead = 0;
+        mTotalQuantity = 0;
+        mOrderCount = 0;
+        mHash = 0;
+    }
+
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    Reserve(size_t orders)
+    {
+        mOrders.reserve(orders);
+        mQueueTree.reserve(orders);
+    }
 
     template <typename OrderPtr> const typename PriceTracker<OrderPtr>::OrderList& PriceTracker<OrderPtr>::
     GetOrders() const
@@ -13,10 +41,16 @@ namespace OrderEngine
         return mOrders;
     }
 
+    template <typename OrderPtr> size_t PriceTracker<OrderPtr>::
+    GetHead() const
+    {
+        return mHead;
+    }
+
     template <typename OrderPtr> bool PriceTracker<OrderPtr>::
     IsEmpty() const
     {
-        return mOrders.empty();
+        return mOrderCount == 0;
     }
 
     template <typename OrderPtr>Base::Quantity PriceTracker<OrderPtr>::
@@ -37,39 +71,256 @@ namespace OrderEngine
         return mOrderCount;
     }
 
-    template <typename OrderPtr> typename PriceTracker<OrderPtr>::OrderIterator PriceTracker<OrderPtr>::
+    template <typename OrderPtr> uint64_t PriceTracker<OrderPtr>::
+    GetHash() const
+    {
+        return mHash;
+    }
+
+    template <typename OrderPtr> typename PriceTracker<OrderPtr>::OrderHandle PriceTracker<OrderPtr>::
     AddOrder(const OrderPtr& order)
     {
+        OrderHandle handle = mBaseSequence + mOrders.size();
+        size_t tail = mOrderCount == 0 ? kNoSlot : mOrders.back() ? mOrders.size() - 1 : liveSlot(mOrderCount - 1);
+        replaceLink(slotHash(tail), kQueueEnd, OrderHash(order->GetId(), mPrice, order->GetOpenQuantity()), kQueueEnd);
         mTotalQuantity += order->GetOpenQuantity();
         mOrderCount++;
-        return mOrders.insert(mOrders.end(), order);
+        mOrders.push_back(order);
+        appendWeight(order->GetOpenQuantity());
+        return handle;
     }
 
     template <typename OrderPtr> void PriceTracker<OrderPtr>::
-    RemoveOrder(const OrderIterator& itr)
+    RemoveOrder(OrderHandle handle)
     {
-        if(itr != mOrders.end())
+        if(handle < mBaseSequence || handle - mBaseSequence >= mOrders.size())
+        {
+            return;
+        }
+
+        size_t index = handle - mBaseSequence;
+        OrderPtr& slot = mOrders[index];
+        if(slot)
         {
-            mTotalQuantity -= (*itr)->GetOpenQuantity();
+            replaceLink(slotHash(prevLive(index)), slotHash(index), kQueueEnd, slotHash(nextLive(index)));
+            mTotalQuantity -= slot->GetOpenQuantity();
             mOrderCount--;
-            mOrders.erase(itr);
+            addWeight(index, -1, -static_cast<int64_t>(slot->GetOpenQuantity()));
+            slot = nullptr;
+            advanceHead();
+        }
+    }
+
+    /**
+     * @brief Skips removed slots at the front of the queue.
+     * @details
+     * - An empty queue is cleared in place, keeping its buffer for the next orders.
+     * - Once enough dead slots pile up in front, they are erased in one go. The base
+     *   sequence moves with them, so handles of live orders stay valid.
+     */
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    advanceHead()
+    {
+        while(mHead < mOrders.size() && !mOrders[mHead])
+        {
+            ++mHead;
+        }
+
+        if(mHead == mOrders.size())
+        {
+            mBaseSequence += mOrders.size();
+            mOrders.clear();
+            mQueueTree.clear();
+            mHead = 0;
+        }
+        else if(mHead >= kCompactThreshold && mHead * 2 >= mOrders.size())
+        {
+            mOrders.erase(mOrders.begin(), mOrders.begin() + static_cast<std::ptrdiff_t>(mHead));
+            mBaseSequence += mHead;
+            mHead = 0;
+            // Slots shifted, the erase already cost O(n) so the tree is rebuilt rather than patched
+            rebuildQueueTree();
+        }
+    }
+
+    /**
+     * @brief Adds a slot at the end of the Fenwick tree in O(log n).
+     * @details The new node covers (i - lowbit(i), i], its value is the new slot plus the
+     *          nodes that tile the rest of that range.
+     */
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    appendWeight(Base::Quantity quantity)
+    {
+        size_t index = mQueueTree.size() + 1; // 1-based
+        QueueWeight node{1, quantity};
+        for (size_t child = index - 1; child > index - (index & (~index + 1)); child -= child & (~child + 1))
+        {
+            node.mCount += mQueueTree[child - 1].mCount;
+            node.mQuantity += mQueueTree[child - 1].mQuantity;
+        }
+        mQueueTree.push_back(node);
+    }
+
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    addWeight(size_t slot, int64_t count, int64_t quantity)
+    {
+        // Unsigned wrap-around makes negative deltas plain additions
+        for (size_t index = slot + 1; index <= mQueueTree.size(); index += index & (~index + 1))
+        {
+            mQueueTree[index - 1].mCount += static_cast<uint64_t>(count);
+            mQueueTree[index - 1].mQuantity += static_cast<Base::Quantity>(quantity);
+        }
+    }
+
+    // Live orders and open quantity in slots [0, slots)
+    template <typename OrderPtr> typename PriceTracker<OrderPtr>::QueueWeight PriceTracker<OrderPtr>::
+    prefixWeight(size_t slots) const
+    {
+        QueueWeight sum;
+        for (size_t index = slots; index > 0; index -= index & (~index + 1))
+        {
+            sum.mCount += mQueueTree[index - 1].mCount;
+            sum.mQuantity += mQueueTree[index - 1].mQuantity;
         }
+        return sum;
     }
 
+    // Linear-time build: every node pushes its total into its parent
     template <typename OrderPtr> void PriceTracker<OrderPtr>::
-    UpdateQuantity(const OrderPtr& order, Base::Quantity oldQty, Base::Quantity newQty)
+    rebuildQueueTree()
+    {
+        mQueueTree.resize(mOrders.size());
+        for (size_t slot = 0; slot < mOrders.size(); ++slot)
+        {
+            mQueueTree[slot] = mOrders[slot] ? QueueWeight{1, mOrders[slot]->GetOpenQuantity()} : QueueWeight{};
+        }
+        for (size_t index = 1; index <= mQueueTree.size(); ++index)
+        {
+            size_t parent = index + (index & (~index + 1));
+            if (parent <= mQueueTree.size())
+            {
+                mQueueTree[parent - 1].mCount += mQueueTree[index - 1].mCount;
+                mQueueTree[parent - 1].mQuantity += mQueueTree[index - 1].mQuantity;
+            }
+        }
+    }
+
+    // Slot of the live order with rank live orders ahead of it, a descent of the Fenwick tree in O(log n)
+    template <typename OrderPtr> size_t PriceTracker<OrderPtr>::
+    liveSlot(uint64_t rank) const
+    {
+        size_t index = 0; // Slots [0, index) hold at most rank live orders
+        for (size_t step = size_t{1} << (63 - __builtin_clzll(mQueueTree.size())); step > 0; step >>= 1)
+        {
+            if (index + step <= mQueueTree.size() && mQueueTree[index + step - 1].mCount <= rank)
+            {
+                index += step;
+                rank -= mQueueTree[index - 1].mCount;
+            }
+        }
+        return index;
+    }
+
+    // Nearest live slot ahead of slot, kNoSlot at the front of the queue
+    template <typename OrderPtr> size_t PriceTracker<OrderPtr>::
+    prevLive(size_t slot) const
+    {
+        if (slot <= mHead)
+        {
+            return kNoSlot;
+        }
+        if (mOrders[slot - 1])
+        {
+            return slot - 1;
+        }
+        uint64_t ahead = prefixWeight(slot).mCount;
+        return ahead == 0 ? kNoSlot : liveSlot(ahead - 1);
+    }
+
+    // Nearest live slot behind slot, kNoSlot at the back of the queue
+    template <typename OrderPtr> size_t PriceTracker<OrderPtr>::
+    nextLive(size_t slot) const
+    {
+        if (slot + 1 < mOrders.size() && mOrders[slot + 1])
+        {
+            return slot + 1;
+        }
+        uint64_t upTo = prefixWeight(slot + 1).mCount;
+        return upTo >= mOrderCount ? kNoSlot : liveSlot(upTo);
+    }
+
+    template <typename OrderPtr> uint64_t PriceTracker<OrderPtr>::
+    slotHash(size_t slot) const
+    {
+        if (slot == kNoSlot)
+        {
+            return kQueueEnd;
+        }
+        return OrderHash(mOrders[slot]->GetId(), mPrice, mOrders[slot]->GetOpenQuantity());
+    }
+
+    /**
+     * @brief Swaps one node of the queue between ahead and behind for another in the level hash.
+     * @details kQueueEnd as the old node inserts the new one, as the new node removes the old one.
+     */
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    replaceLink(uint64_t ahead, uint64_t oldHash, uint64_t newHash, uint64_t behind)
+    {
+        auto span = [&](uint64_t node) {
+            return node == kQueueEnd ? LinkHash(ahead, behind) : LinkHash(ahead, node) + LinkHash(node, behind);
+        };
+        mHash += span(newHash) - span(oldHash);
+    }
+
+    template <typename OrderPtr> bool PriceTracker<OrderPtr>::
+    GetQueuePosition(OrderHandle handle, Base::QueuePosition& position) const
+    {
+        if (!GetOrder(handle))
+        {
+            return false;
+        }
+
+        QueueWeight ahead = prefixWeight(handle - mBaseSequence);
+        position = {mPrice, ahead.mCount, ahead.mQuantity};
+        return true;
+    }
+
+    template <typename OrderPtr> void PriceTracker<OrderPtr>::
+    UpdateQuantity(OrderHandle handle, Base::Quantity oldQty, Base::Quantity newQty)
     {
         mTotalQuantity += (newQty-oldQty); // O(1)
+
+        size_t index = handle - mBaseSequence;
+        Base::OrderId orderId = mOrders[index]->GetId();
+        replaceLink(slotHash(prevLive(index)), OrderHash(orderId, mPrice, oldQty), OrderHash(orderId, mPrice, newQty),
+                    slotHash(nextLive(index)));
+        addWeight(index, 0, static_cast<int64_t>(newQty) - static_cast<int64_t>(oldQty));
+    }
+
+    template <typename OrderPtr>
+    OrderPtr PriceTracker<OrderPtr>::GetOrder(OrderHandle handle) const
+    {
+        if(handle < mBaseSequence || handle - mBaseSequence >= mOrders.size())
+        {
+            return nullptr;
+        }
+        return mOrders[handle - mBaseSequence];
     }
 
     template <typename OrderPtr>
     OrderPtr PriceTracker<OrderPtr>::FrontOrder() const
     {
-        return mOrders.empty() ? nullptr : mOrders.front();
+        return mHead < mOrders.size() ? mOrders[mHead] : nullptr;
+    }
+
+    template <typename OrderPtr>
+    OrderPtr PriceTracker<OrderPtr>::GetTopOrder() const
+    {
+        return GetOrder(mTopSequence);
     }
 
     /**
-     * @brief Fill order at this price level up a specified quantity 
+     * @brief Fill order at this price level up a specified quantity
      * @details
      * - Example:
      *   This takes buy order and tries to fill it by matching against sell orders.
@@ -77,54 +328,68 @@ namespace OrderEngine
      */
     template <typename OrderPtr> Base::Quantity PriceTracker<OrderPtr>::
     FillQuantity(Base::Quantity maxQty)
-    {   
+    {
         // Tracks how many orders we have fulfilled so far
-        Base::Quantity totalFilled = 0; 
+        Base::Quantity totalFilled = 0;
 
-        // Iterator to the first resting order in the orderbook
-        auto it = mOrders.begin();
+        // Index of the first resting order in the orderbook
+        size_t slot = mHead;
 
-        while( it != mOrders.end() && totalFilled < maxQty )
+        while( slot < mOrders.size() && totalFilled < maxQty )
         {
-            auto currRestingOrder = *it;
-            
+            auto currRestingOrder = mOrders[slot];
+            if(!currRestingOrder)
+            {
+                ++slot;
+                continue;
+            }
+
             // Shares available in the resting order
             Base::Quantity sharesAvailable  = currRestingOrder->GetOpenQuantity();
 
             // Number of shares we can extract from current resting order
             Base::Quantity sharesToFill = std::min(sharesAvailable , maxQty - totalFilled);
-            
+
             if (sharesToFill == 0)
             {
                 break;
             }
 
+            // Every order ahead of this one was filled whole, it is at the front of the queue
+            uint64_t behind = slotHash(nextLive(slot));
+            uint64_t oldHash = OrderHash(currRestingOrder->GetId(), mPrice, sharesAvailable);
+
             // Apply fill
             currRestingOrder->SetOpenQuantity(sharesAvailable - sharesToFill);
             totalFilled += sharesToFill;
             mTotalQuantity -= sharesToFill;
-            
+
 
             if( currRestingOrder->GetOpenQuantity() == 0 )
             {
                 // Incoming order is completely filled
                 currRestingOrder->SetOrderStatus(Base::OrderStatus::FILLED);
-                
-                // Remove this resting order from the list and move to next  
-                it = mOrders.erase(it);
-                mOrderCount--; // 
+
+                // Clear this resting order's slot and move to next
+                replaceLink(kQueueEnd, oldHash, kQueueEnd, behind);
+                mOrders[slot] = nullptr;
+                mOrderCount--; //
+                addWeight(slot, -1, -static_cast<int64_t>(sharesAvailable));
             }
             else
             {
-                // Incoming order is partially filled 
+                // Incoming order is partially filled
                 currRestingOrder->SetOrderStatus(Base::OrderStatus::PARTIALLY_FILLED);
-                it++;
+                replaceLink(kQueueEnd, oldHash, slotHash(slot), behind);
+                addWeight(slot, 0, -static_cast<int64_t>(sharesToFill));
             }
+            ++slot;
         }
 
+        advanceHead();
         return totalFilled;
     }
 
     template class PriceTracker<Order*>;
 
-} // namespace OrderEngine
\ No newline at end of file
+} // namespace OrderEngine
@@ -6,59 +6,153 @@
 #include <map>
 #include <memory>
 #include "../OrderTypes.h"
+#include "../Memory/Arena.h"
 
 namespace OrderEngine
 {
     /**
-     * @brief Represents a single price point in the order book. 
-     * 
+     * @brief Represents a single price point in the order book.
+     *
      * @details
      * - PriceTracker groups all the active orderes submitted at that price.
-     * - It maintains both the list of orders (FIFO by entry time) and 
-     *   aggregate statistics like total open quantity and order count. 
+     * - It maintains both the list of orders (FIFO by entry time) and
+     *   aggregate statistics like total open quantity and order count.
      * - Think of an orderbook like a building with floors, where each floor represents a different price.
+     * - Removed orders leave an empty slot (nullptr) behind, so the handle of every other
+     *   order stays valid. Empty slots at the front are skipped and compacted lazily.
+     * - Keeps a rolling hash of its queue: the wrapping sum of LinkHash over every pair of
+     *   neighbouring live orders, queue ends included. It depends only on which orders are live,
+     *   in which order and with which quantities, not on the adds and cancels that got there.
+     *   Updated on each add, fill and remove, an empty level hashes to 0.
+     * - A Fenwick tree over the queue slots holds each slot's live order count and open quantity,
+     *   so the orders and quantity ahead of any slot are a prefix sum in O(log n).
      */
     template<typename OrderPtr> class PriceTracker
     {
 
     public:
-        using OrderList = std::vector<OrderPtr>; 
-        using OrderIterator = typename OrderList::iterator;
+        using OrderList = std::vector<OrderPtr, ArenaAllocator<OrderPtr>>;
+
+        /**
+         * Stable reference to an order in this level: the order's enqueue sequence number.
+         * Unlike a vector iterator it survives removal of other orders and compaction.
+         */
+        using OrderHandle = uint64_t;
 
     private:
-        Base::Price mPrice = 0; // Price to which this tracker(OrderList) corresponds 
-        OrderList mOrders; 
+        // Fenwick tree node: live orders and open quantity of a range of slots
+        struct QueueWeight
+        {
+            uint64_t mCount = 0;
+            Base::Quantity mQuantity = 0;
+        };
+        using QueueTree = std::vector<QueueWeight, ArenaAllocator<QueueWeight>>;
+
+        Base::Price mPrice = 0; // Price to which this tracker(OrderList) corresponds
+        OrderList mOrders; // Queue slots, removed orders are nullptr
+        QueueTree mQueueTree; // Fenwick tree over mOrders, node i covers slots (i - lowbit(i), i]
+        size_t mHead = 0; // Index of the first live slot in mOrders
+        uint64_t mBaseSequence = 0; // Enqueue sequence number of mOrders[0]
+        uint64_t mTopSequence = 0; // Enqueue sequence number of the order that opened this level
         Base::Quantity mTotalQuantity = 0; // Total quantity of all orders at this price
         uint64_t mOrderCount = 0; // Total number of orders at this price
+        uint64_t mHash = 0; // Sum of LinkHash over neighbouring live orders
+
+        void advanceHead();
+        void appendWeight(Base::Quantity quantity);
+        void addWeight(size_t slot, int64_t count, int64_t quantity);
+        QueueWeight prefixWeight(size_t slots) const;
+        void rebuildQueueTree();
+        size_t liveSlot(uint64_t rank) const;
+        size_t prevLive(size_t slot) const;
+        size_t nextLive(size_t slot) const;
+        uint64_t slotHash(size_t slot) const;
+        void replaceLink(uint64_t ahead, uint64_t oldHash, uint64_t newHash, uint64_t behind);
 
     public:
-        explicit PriceTracker(Base::Price price);
+        // Queue buffer comes from arena, the global heap if it is null
+        explicit PriceTracker(Base::Price price, Arena* arena = nullptr);
+
+        /**
+         * @brief Reuses this tracker for another price level.
+         * @details Drops all orders but keeps the queue buffer allocated.
+         */
+        void Reset(Base::Price price);
+
+        // Sizes the queue buffer and its tree for orders enqueued orders
+        void Reserve(size_t orders);
+
+        // Stands for the front or the back of the queue in LinkHash
+        static constexpr uint64_t kQueueEnd = 0;
+
+        static uint64_t Mix(uint64_t x)
+        {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        // 64-bit mix of one order's state
+        static uint64_t OrderHash(Base::OrderId orderId, Base::Price price, Base::Quantity quantity)
+        {
+            return Mix(orderId ^ Mix(static_cast<uint64_t>(price) ^ Mix(quantity)));
+        }
+
+        /**
+         * @brief Hash of one order queued directly ahead of another, the unit of the level hash.
+         * @details Asymmetric, so the sum over a queue's links also covers queue priority.
+         *          The two ends of an empty queue link to nothing.
+         */
+        static uint64_t LinkHash(uint64_t ahead, uint64_t behind)
+        {
+            return ahead == kQueueEnd && behind == kQueueEnd ? 0 : Mix(ahead * 0x9e3779b97f4a7c15ull + behind);
+        }
+
         Base::Price GetPrice() const;
         Base::Quantity GetTotalQuantity() const;
         uint64_t GetOrderCount() const;
+        uint64_t GetHash() const;
         bool IsEmpty() const;
-        // Returns the list of orders at this price
+        // Returns the queue slots at this price, live orders start at GetHead() and removed slots are nullptr
         const OrderList& GetOrders() const;
+        size_t GetHead() const;
 
         /**
          * @brief Adds a new order to the list of tracked orders.
+         * @return Handle used to remove or update the order later.
          */
-        OrderIterator AddOrder(const OrderPtr& order);
-        
+        OrderHandle AddOrder(const OrderPtr& order);
+
         /**
          * @brief Removes an order from the list of tracked orders.
-         * 
+         *
          * @details
          * - This is typically called when an order is fully filled or cancelled.
          * - It updates the total quantity and order count accordingly.
+         * - Must be called before the order's open quantity is zeroed.
          */
-        void RemoveOrder(const OrderIterator& it);
+        void RemoveOrder(OrderHandle handle);
 
-        void UpdateQuantity(const OrderPtr& order, Base::Quantity oldQty, Base::Quantity newQty);
+        // Moves the order behind handle from oldQty to newQty, the caller sets the order's open quantity
+        void UpdateQuantity(OrderHandle handle, Base::Quantity oldQty, Base::Quantity newQty);
+
+        // Order behind a handle, nullptr if it has been removed
+        OrderPtr GetOrder(OrderHandle handle) const;
 
         // Get the first order in the list (FIFO)
         OrderPtr FrontOrder() const;
 
+        // The order that opened this level, nullptr once it has left the level
+        OrderPtr GetTopOrder() const;
+
+        /**
+         * @brief Live orders and open quantity queued ahead of the order behind handle, in O(log n).
+         * @return false if the handle does not name a live order
+         */
+        bool GetQueuePosition(OrderHandle handle, Base::QueuePosition& position) const;
+
         Base::Quantity FillQuantity(Base::Quantity maxQty);
     };
 
@@ -66,4 +160,4 @@ namespace OrderEngine
     extern template class PriceTracker<Order*>;
 }
 
-#endif // PRICE_TRACKER_H
\ No newline at end of file
+#endif // PRICE_TRACKER_H
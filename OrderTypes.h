@@ -20,6 +20,7 @@ namespace OrderEngine
         using Quantity = uint64_t;
         using OrderId = uint64_t;
         using Symbol = std::string;
+        using OwnerId = uint64_t; // Session or account that owns an order
         using Timestamp = std::chrono::high_resolution_clock::time_point;
 
         /*
@@ -31,6 +32,11 @@ namespace OrderEngine
             SELL = 'S'
         };
 
+        constexpr OrderSide Opposite(OrderSide side)
+        {
+            return side == OrderSide::BUY ? OrderSide::SELL : OrderSide::BUY;
+        }
+
         enum class OrderType : char {
             LIMIT = 'L',
             MARKET = 'M',
@@ -46,7 +52,23 @@ namespace OrderEngine
             FILLED = 'C',
             REJECTED = 'R',
             REPLACED = 'E',
-            CANCELLED = 'X'
+            CANCELLED = 'X',
+            EXPIRED = 'D'
+        };
+
+        /*
+         * How long a resting order stays in the book
+         * - GTC: Good till cancelled, never expires
+         * - DAY: Expires at the session close of the book
+         * - GTD: Good till date, expires at the order's expire time
+         * - GTT: Good till time, same as GTD with an intraday expire time
+        */
+        enum class TimeInForce : char
+        {
+            GTC = '1',
+            DAY = '0',
+            GTD = '6',
+            GTT = 'T'
         };
 
         /* Bitmask flags describing the characteristics of a trade fill.
@@ -75,6 +97,37 @@ namespace OrderEngine
             return a;
         }
 
+        /*
+         * Trading phase of an order book
+         * - CONTINUOUS: Incoming orders are matched immediately
+         * - AUCTION   : Call phase, orders accumulate without matching until the uncross
+        */
+        enum class TradingPhase : char
+        {
+            CONTINUOUS = 'C',
+            AUCTION = 'A'
+        };
+
+        /*
+         * Aggregated view of one price level, used for depth and auction computations
+        */
+        struct LevelInfo
+        {
+            Price mPrice{};
+            Quantity mQuantity{};
+            uint64_t mOrderCount{};
+        };
+
+        /*
+         * Where a resting order stands in its level: live orders and open quantity queued ahead of it
+        */
+        struct QueuePosition
+        {
+            Price mPrice{};
+            uint64_t mOrdersAhead{};
+            Quantity mQuantityAhead{};
+        };
+
         enum OrderConditions : uint32_t {
             NO_CONDITIONS = 0,
             ALL_OR_NONE = 1 << 0,
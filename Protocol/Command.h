@@ -0,0 +1,73 @@
+#pragma once
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <cstdint>
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @brief Book operations as captured in a command log.
+     */
+    enum class CommandType : uint8_t
+    {
+        ADD_ORDER = 'A',
+        CANCEL_ORDER = 'X',
+        CANCEL_OWNER = 'O',     // Mass cancel of mOwner's orders
+        EXPIRE = 'E',           // Expiry sweep at mTimestampNs
+        START_AUCTION = 'S',
+        UNCROSS_AUCTION = 'U',  // Uncross with mPrice as the reference price
+        CHECKPOINT = 'K'        // Replication marker: book checksum mQuantity once input sequence mOrderId is applied
+    };
+
+    /**
+     * @struct Command
+     * @brief One fixed-size record of a command log, the unit of capture and replay.
+     *
+     * @details
+     * - Fixed 64 bytes so a log can be mmap'd and walked as a plain array, no parsing.
+     * - Fields a command type does not use are zero.
+     * - Times are nanoseconds since the epoch of the capturing clock.
+     * - The layout is part of the log format, bump kCommandLogVersion when it changes.
+     */
+    struct Command
+    {
+        uint64_t mTimestampNs;      // Capture time
+        Base::OrderId mOrderId;
+        Base::OwnerId mOwner;
+        Base::Price mPrice;
+        Base::Price mStopPrice;
+        Base::Quantity mQuantity;
+        uint64_t mExpireTimeNs;     // GTD/GTT expiry, 0 if none
+        uint16_t mBook;             // Index into the log's symbol table
+        CommandType mType;
+        Base::OrderSide mSide;
+        Base::OrderType mOrderType;
+        Base::TimeInForce mTimeInForce;
+        uint8_t mConditions;        // Base::OrderConditions
+        uint8_t mReserved;
+    };
+    static_assert(sizeof(Command) == 64, "Command is part of the log format");
+
+    /**
+     * @struct CommandLogHeader
+     * @brief Start of a command log file, followed by mCommandCount Command records.
+     */
+    struct CommandLogHeader
+    {
+        static constexpr size_t kMaxBooks = 64;
+        static constexpr size_t kSymbolSize = 16;
+
+        uint64_t mMagic;
+        uint32_t mVersion;
+        uint32_t mBookCount;
+        uint64_t mCommandCount;
+        uint64_t mReserved;
+        char mSymbols[kMaxBooks][kSymbolSize];
+    };
+
+    static constexpr uint64_t kCommandLogMagic = 0x474F4C444D434D45ull; // "EMCMDLOG"
+    static constexpr uint32_t kCommandLogVersion = 1;
+} // namespace OrderEngine
+
+#endif //COMMAND_H
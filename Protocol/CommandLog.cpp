@@ -0,0 +1,186 @@
+#include "CommandLog.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OrderEngine {
+
+    static std::runtime_error logError(const std::string& what, const std::string& path)
+    {
+        return std::runtime_error("CommandLog " + path + ": " + what + " (" + std::strerror(errno) + ")");
+    }
+
+    // ==== Writer ====
+
+    CommandLogWriter::CommandLogWriter(const std::string& path)
+        : mPath(path)
+    {
+        mFile = std::fopen(path.c_str(), "wb");
+        if (!mFile) {
+            throw logError("open failed", path);
+        }
+        mHeader.mVersion = kCommandLogVersion;
+
+        // Placeholder header without magic, a log that was never closed is rejected by readers
+        if (std::fwrite(&mHeader, sizeof(mHeader), 1, mFile) != 1) {
+            std::fclose(mFile);
+            mFile = nullptr;
+            throw logError("write failed", path);
+        }
+    }
+
+    CommandLogWriter::~CommandLogWriter()
+    {
+        if (mFile) {
+            Close(); // todo: log a failure, callers that care call Close() themselves
+        }
+    }
+
+    uint16_t CommandLogWriter::AddBook(const std::string& symbol)
+    {
+        if (mHeader.mBookCount == CommandLogHeader::kMaxBooks) {
+            throw std::runtime_error("CommandLog " + mPath + ": symbol table full");
+        }
+        std::strncpy(mHeader.mSymbols[mHeader.mBookCount], symbol.c_str(), CommandLogHeader::kSymbolSize - 1);
+        return static_cast<uint16_t>(mHeader.mBookCount++);
+    }
+
+    bool CommandLogWriter::Append(const Command& command)
+    {
+        if (mError != 0) {
+            return false;
+        }
+        if (std::fwrite(&command, sizeof(command), 1, mFile) != 1) {
+            fail(); // todo: log
+            return false;
+        }
+        ++mHeader.mCommandCount;
+        return true;
+    }
+
+    bool CommandLogWriter::Append(uint64_t sequence, const Command& command)
+    {
+        if (sequence != mHeader.mCommandCount + 1) {
+            return false; // todo: log
+        }
+        return Append(command);
+    }
+
+    uint64_t CommandLogWriter::GetLastSequence() const
+    {
+        return mHeader.mCommandCount;
+    }
+
+    bool CommandLogWriter::Close()
+    {
+        if (!mFile) {
+            return mError == 0;
+        }
+        // Records first: a header claiming records the file does not hold must never be stamped
+        if (mError == 0 && std::fflush(mFile) != 0) {
+            fail();
+        }
+        if (mError == 0) {
+            mHeader.mMagic = kCommandLogMagic;
+            if (std::fseek(mFile, 0, SEEK_SET) != 0 || std::fwrite(&mHeader, sizeof(mHeader), 1, mFile) != 1) {
+                fail();
+            }
+        }
+        if (std::fclose(mFile) != 0) {
+            fail();
+        }
+        mFile = nullptr;
+        return mError == 0;
+    }
+
+    int CommandLogWriter::GetError() const
+    {
+        return mError;
+    }
+
+    // Keeps the first failure, errno can be 0 after a short fwrite
+    void CommandLogWriter::fail()
+    {
+        if (mError == 0) {
+            mError = errno != 0 ? errno : EIO;
+        }
+    }
+
+    // ==== Reader ====
+
+    CommandLogReader::CommandLogReader(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw logError("open failed", path);
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CommandLogHeader)) {
+            close(fd);
+            throw std::runtime_error("CommandLog " + path + ": file too small");
+        }
+
+        mSize = static_cast<size_t>(st.st_size);
+        mBase = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mBase == MAP_FAILED) {
+            mBase = nullptr;
+            throw logError("mmap failed", path);
+        }
+        // The log is streamed front to back
+        madvise(mBase, mSize, MADV_SEQUENTIAL);
+
+        const CommandLogHeader& h = header();
+        if (h.mMagic != kCommandLogMagic || h.mVersion != kCommandLogVersion
+            || h.mBookCount > CommandLogHeader::kMaxBooks
+            || sizeof(CommandLogHeader) + h.mCommandCount * sizeof(Command) > mSize) {
+            munmap(mBase, mSize);
+            mBase = nullptr;
+            throw std::runtime_error("CommandLog " + path + ": unexpected layout");
+        }
+    }
+
+    CommandLogReader::~CommandLogReader()
+    {
+        if (mBase) {
+            munmap(mBase, mSize);
+        }
+    }
+
+    const CommandLogHeader& CommandLogReader::header() const
+    {
+        return *static_cast<const CommandLogHeader*>(mBase);
+    }
+
+    uint32_t CommandLogReader::GetBookCount() const
+    {
+        return header().mBookCount;
+    }
+
+    std::string CommandLogReader::GetSymbol(uint16_t book) const
+    {
+        const char* symbol = header().mSymbols[book];
+        return std::string(symbol, strnlen(symbol, CommandLogHeader::kSymbolSize));
+    }
+
+    size_t CommandLogReader::size() const
+    {
+        return header().mCommandCount;
+    }
+
+    const Command* CommandLogReader::begin() const
+    {
+        return reinterpret_cast<const Command*>(static_cast<const char*>(mBase) + sizeof(CommandLogHeader));
+    }
+
+    const Command* CommandLogReader::end() const
+    {
+        return begin() + size();
+    }
+} // namespace OrderEngine
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef COMMAND_LOG_H
+#define COMMAND_LOG_H
+
+#include <cstdio>
+#include <string>
+#include "Command.h"
+
+namespace OrderEngine {
+    /**
+     * @class CommandLogWriter
+     * @brief Appends commands to a log file.
+     * @details
+     * - Buffered writes; the header (with the final command count) is written on Close().
+     * - The first failed write fails the writer: every later Append is refused and Close leaves
+     *   the header unstamped, so readers reject the log rather than see a silently short one.
+     */
+    class CommandLogWriter
+    {
+    public:
+        /**
+         * @throws std::runtime_error if the file cannot be created
+         */
+        explicit CommandLogWriter(const std::string& path);
+        ~CommandLogWriter();
+        CommandLogWriter(const CommandLogWriter&) = delete;
+        CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+
+        /**
+         * @brief Adds a symbol to the log's symbol table.
+         * @return Book index to put in Command::mBook
+         * @throws std::runtime_error once kMaxBooks symbols have been added
+         */
+        uint16_t AddBook(const std::string& symbol);
+
+        // False if the command was not written: a short write now or an earlier failure
+        bool Append(const Command& command);
+
+        /**
+         * @brief Appends a command delivered by the MpscSequencer.
+         * @details Record N of the log holds sequence N + 1, so the sequence itself is not stored.
+         * @return false, and nothing written, if sequence does not follow the last record (gap or replay)
+         *         or the write failed
+         */
+        bool Append(uint64_t sequence, const Command& command);
+
+        // Sequence of the last record, 0 for an empty log
+        uint64_t GetLastSequence() const;
+
+        /**
+         * @brief Finalizes the header and closes the file, called by the destructor if needed.
+         * @return false if any write, the header rewrite or the close failed, see GetError()
+         */
+        bool Close();
+
+        // errno of the first failure, 0 while every write succeeded
+        int GetError() const;
+
+    private:
+        std::FILE* mFile = nullptr;
+        std::string mPath;
+        CommandLogHeader mHeader{};
+        int mError = 0;
+
+        void fail();
+    };
+
+    /**
+     * @class CommandLogReader
+     * @brief Read-only mmap of a command log, commands are walked in place as an array.
+     */
+    class CommandLogReader
+    {
+    public:
+        /**
+         * @throws std::runtime_error if the file cannot be mapped or has an unexpected layout
+         */
+        explicit CommandLogReader(const std::string& path);
+        ~CommandLogReader();
+        CommandLogReader(const CommandLogReader&) = delete;
+        CommandLogReader& operator=(const CommandLogReader&) = delete;
+
+        uint32_t GetBookCount() const;
+        std::string GetSymbol(uint16_t book) const;
+
+        size_t size() const;
+        const Command* begin() const;
+        const Command* end() const;
+
+    private:
+        void* mBase = nullptr;
+        size_t mSize = 0;
+
+        const CommandLogHeader& header() const;
+    };
+} // namespace OrderEngine
+
+#endif //COMMAND_LOG_H
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef EXECUTION_REPORT_H
+#define EXECUTION_REPORT_H
+
+#include <cstdint>
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @brief Kind of execution report, values follow FIX ExecType.
+     */
+    enum class ExecType : char
+    {
+        NEW = '0',
+        CANCELED = '4',
+        REJECTED = '8',
+        TRADE = 'F'
+    };
+
+    /**
+     * @struct ExecutionReport
+     * @brief Outbound message for one order event, fixed 64 bytes like Command.
+     * @details
+     * - A fill produces one report for each side, mContraOrderId names the other order.
+     * - mSendTimestampNs echoes the capture time of the command that caused the report, so the
+     *   receiver can measure the full round trip.
+     */
+    struct ExecutionReport
+    {
+        uint64_t mSendTimestampNs;
+        Base::OrderId mOrderId;
+        Base::OrderId mContraOrderId;
+        Base::Price mPrice;
+        Base::Quantity mLastQuantity;
+        Base::Quantity mLeavesQuantity;
+        uint64_t mExecId;           // Sequence number of the report within its book
+        uint16_t mBook;
+        ExecType mExecType;
+        Base::OrderStatus mStatus;
+        Base::OrderSide mSide;
+        uint8_t mReserved[3];
+    };
+    static_assert(sizeof(ExecutionReport) == 64, "ExecutionReport is part of the wire format");
+} // namespace OrderEngine
+
+#endif //EXECUTION_REPORT_H
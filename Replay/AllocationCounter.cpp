@@ -0,0 +1,123 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<bool> gArmed{false};
+    std::atomic<uint64_t> gAllocations{0};
+
+    inline void countAllocation()
+    {
+        if (gArmed.load(std::memory_order_relaxed)) {
+            gAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+#if defined(__GLIBC__)
+// glibc exports its allocator under these names, the replacements below forward to them
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+
+    void* malloc(size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_realloc(ptr, size);
+    }
+}
+
+// operator new counts itself, it must not go through the counting malloc again
+static void* rawAllocate(size_t size, size_t alignment)
+{
+    return alignment <= alignof(std::max_align_t) ? __libc_malloc(size) : __libc_memalign(alignment, size);
+}
+#else
+static void* rawAllocate(size_t size, size_t alignment)
+{
+    return alignment <= alignof(std::max_align_t)
+        ? std::malloc(size)
+        : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+#endif
+
+static void* countedNew(size_t size, size_t alignment)
+{
+    countAllocation();
+    return rawAllocate(size == 0 ? 1 : size, alignment);
+}
+
+static void* countedNewOrThrow(size_t size, size_t alignment)
+{
+    void* ptr = countedNew(size, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// The default operator delete releases with free(), which pairs with every allocation above
+void* operator new(size_t size)
+{
+    return countedNewOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+    return countedNewOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return countedNewOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return countedNewOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedNew(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedNew(size, alignof(std::max_align_t));
+}
+
+namespace OrderEngine {
+    void ArmAllocationCounter()
+    {
+        gArmed.store(true, std::memory_order_relaxed);
+    }
+
+    void DisarmAllocationCounter()
+    {
+        gArmed.store(false, std::memory_order_relaxed);
+    }
+
+    uint64_t GetAllocationCount()
+    {
+        return gAllocations.load(std::memory_order_relaxed);
+    }
+} // namespace OrderEngine
@@ -0,0 +1,19 @@
+#pragma once
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace OrderEngine {
+    /**
+     * Process-wide heap allocation counter of the allocation-check build (MatchingEngine_alloccheck).
+     * - Its translation unit replaces the global operator new family and, on glibc, malloc, calloc
+     *   and realloc. Every call made while the counter is armed is counted, from any thread.
+     * - Only link it into a binary that is meant to check, the replacements apply to the whole program.
+     */
+    void ArmAllocationCounter();
+    void DisarmAllocationCounter();
+    uint64_t GetAllocationCount();
+} // namespace OrderEngine
+
+#endif //ALLOCATION_COUNTER_H
@@ -0,0 +1,527 @@
+/**
+ * @file ReplayMain.cpp
+ * @brief Streams a captured command log through the order books as fast as possible.
+ *
+ * Usage:
+ *   MatchingEngine_replay <log> [--policy fifo|prorata|toporder] [--store <dir>] [--conflate N] [--stats NAME] [--warmup N]
+ *   MatchingEngine_replay --generate <log> [--count N] [--books N] [--seed N]
+ *   MatchingEngine_replay --query <dir>/<symbol>.trades [--from NS] [--to NS]
+ *
+ * Reports throughput, the per-command latency distribution, a hash of the trade stream, a
+ * hash of the final book state and the books' rolling checksums. Replaying the same log must
+ * always give the same hashes, so they tell whether a build or an optimization changed matching outcomes.
+ *
+ * The log is mmap'd and walked in place. Orders are constructed outside the timed region,
+ * only the book call itself is measured.
+ *
+ * With --store the trades of every book are also appended to <dir>/<symbol>.trades, stamped
+ * with the command timestamp. --query range-scans such a file.
+ *
+ * With --conflate the books feed a DepthConflator with two subscribers, one reading after every
+ * command and one every N commands, and the update counts of both are reported. Each update
+ * carries the input sequence of the command behind it, its record number in the log plus one.
+ *
+ * With --stats every book mirrors its counters into the shared memory segment NAME for the
+ * duration of the run, MatchingEngine_stats NAME reads them from another terminal.
+ *
+ * Built as MatchingEngine_alloccheck (ORDER_ENGINE_ALLOCATION_CHECK) the books run in
+ * zero-allocation mode: capacities reserved from an OrderBookConfig, containers on one arena.
+ * Every heap allocation made by a book call after --warmup N commands is counted and the run
+ * fails (exit code 4) if there is any.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../MarketData/DepthConflator.h"
+#include "../Monitoring/StatsSegment.h"
+#include "../Order.h"
+#include "../OrderBook/OrderBook.h"
+#include "../Protocol/CommandLog.h"
+#include "../Storage/TradeStore.h"
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+#include "../Memory/Arena.h"
+#include "AllocationCounter.h"
+#endif
+
+namespace
+{
+    using namespace OrderEngine;
+    using Clock = std::chrono::steady_clock;
+
+    // ==== FNV-1a, stable across platforms and builds ====
+    class Hasher
+    {
+    public:
+        template<typename T> void Add(T value)
+        {
+            auto bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                mHash = (mHash ^ bytes[i]) * 0x100000001b3ull;
+            }
+        }
+
+        uint64_t Get() const { return mHash; }
+
+    private:
+        uint64_t mHash = 0xcbf29ce484222325ull;
+    };
+
+    Base::Timestamp fromNanos(uint64_t nanos)
+    {
+        return Base::Timestamp(std::chrono::duration_cast<Base::Timestamp::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    template<typename Book> void hashTrades(std::vector<typename Book::TradeExecution>& trades, Hasher& hasher)
+    {
+        // Execution timestamps are wall clock, they are left out on purpose
+        for (const auto& trade : trades) {
+            hasher.Add(trade.mInBoundOrder->GetId());
+            hasher.Add(trade.mRestingOrder->GetId());
+            hasher.Add(trade.mQuantity);
+            hasher.Add(trade.mPrice);
+            hasher.Add(static_cast<uint32_t>(trade.mFlags));
+        }
+    }
+
+    template<typename Book> void storeTrades(std::vector<typename Book::TradeExecution>& trades, uint64_t timestampNs,
+                                             TradeStoreWriter& store)
+    {
+        for (const auto& trade : trades) {
+            store.Append({static_cast<int64_t>(timestampNs), trade.mPrice, trade.mQuantity, static_cast<uint32_t>(trade.mFlags),
+                          trade.mInBoundOrder->GetId(), trade.mRestingOrder->GetId()});
+        }
+    }
+
+    struct ReplayOptions
+    {
+        std::string mStoreDir;
+        size_t mConflateEvery = 0;  // 0 leaves depth conflation off
+        std::string mStatsSegment;  // Empty leaves the stats segment off
+        size_t mWarmup = 0;         // Commands replayed before allocations are counted (allocation-check build)
+    };
+
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+    // Per book, sized for the peak of the generated flow; the arena takes whatever grows past it
+    constexpr OrderBookConfig kPresizedBook{4096, 64, size_t{1} << 18, 4096, 4096};
+    constexpr size_t kCheckArenaBytes = size_t{512} << 20;
+#endif
+
+    // Depth subscribers of a --conflate run: one reads after every command, one every N commands
+    enum Subscriber : size_t
+    {
+        FAST_READER,
+        SLOW_READER,
+        kSubscriberCount
+    };
+
+    template<typename MatchingPolicy>
+    int replay(const CommandLogReader& log, const ReplayOptions& options)
+    {
+        // Only this thread touches the books: no lock, plain counters
+        using Book = OrderBook<Order*, MatchingPolicy, SingleThreadedPolicy>;
+
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+        // Declared first, the books hand their containers back to it when they are destroyed
+        ArenaConfig arenaConfig;
+        arenaConfig.mSize = kCheckArenaBytes;
+        Arena arena(arenaConfig);
+#endif
+        // Declared before the books, they write their records until they are destroyed
+        std::unique_ptr<StatsSegment> stats;
+        if (!options.mStatsSegment.empty()) {
+            stats = std::make_unique<StatsSegment>(StatsSegment::Create(options.mStatsSegment, log.GetBookCount()));
+        }
+        std::vector<std::unique_ptr<Book>> books;
+        std::vector<std::unique_ptr<TradeStoreWriter>> stores;
+        std::unique_ptr<DepthConflator> conflator;
+        if (options.mConflateEvery != 0) {
+            conflator = std::make_unique<DepthConflator>(log.GetBookCount(), kSubscriberCount);
+        }
+        for (uint16_t i = 0; i < log.GetBookCount(); ++i) {
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+            books.push_back(std::make_unique<Book>(log.GetSymbol(i), kPresizedBook, &arena));
+#else
+            books.push_back(std::make_unique<Book>(log.GetSymbol(i)));
+#endif
+            if (!options.mStoreDir.empty()) {
+                stores.push_back(std::make_unique<TradeStoreWriter>(options.mStoreDir + "/" + log.GetSymbol(i) + ".trades", log.GetSymbol(i)));
+            }
+            if (conflator) {
+                books.back()->setDepthListener(&conflator->GetBookListener(i));
+            }
+            if (stats) {
+                books.back()->attachStatsRecord(stats->AddBook(log.GetSymbol(i)));
+            }
+        }
+        std::vector<DepthLevelUpdate> depthUpdates;
+        uint64_t depthUpdateCounts[kSubscriberCount] = {};
+        uint64_t commandIndex = 0;
+
+        // Orders must outlive the books and keep their addresses, reserve all of them up front
+        size_t addCount = 0;
+        for (const Command& command : log) {
+            addCount += command.mType == CommandType::ADD_ORDER;
+        }
+        std::vector<Order> orders;
+        orders.reserve(addCount);
+
+        std::vector<typename Book::TradeExecution> trades;
+        trades.reserve(1024);
+        Hasher tradeHash;
+        uint64_t tradeCount = 0;
+        uint64_t skipped = 0;
+        LatencyHistogram latency;
+
+        auto start = Clock::now();
+        for (const Command& command : log) {
+            ++commandIndex;
+            if (command.mBook >= books.size()) {
+                ++skipped;
+                continue;
+            }
+            Book& book = *books[command.mBook];
+
+            Order* order = nullptr;
+            if (command.mType == CommandType::ADD_ORDER) {
+                order = &orders.emplace_back(command.mOrderId, log.GetSymbol(command.mBook), command.mSide,
+                                             command.mQuantity, command.mPrice, command.mStopPrice);
+                order->SetType(command.mOrderType);
+                order->SetOwner(command.mOwner);
+                order->SetTimeInForce(command.mTimeInForce);
+                if (command.mExpireTimeNs != 0) {
+                    order->SetExpireTime(fromNanos(command.mExpireTimeNs));
+                }
+                // Expiry follows the log's clock, whenever the replay runs
+                book.startExpiryClock(fromNanos(command.mTimestampNs));
+            }
+
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+            if (commandIndex > options.mWarmup) {
+                ArmAllocationCounter();
+            }
+#endif
+            if (conflator) {
+                // Record N of the log holds input sequence N + 1
+                conflator->SetInputSequence(command.mBook, commandIndex);
+            }
+            auto t0 = Clock::now();
+            switch (command.mType) {
+                case CommandType::ADD_ORDER:
+                    book.addOrder(order, static_cast<Base::OrderConditions>(command.mConditions));
+                    break;
+                case CommandType::CANCEL_ORDER:
+                    book.cancelOrder(command.mOrderId);
+                    break;
+                case CommandType::CANCEL_OWNER:
+                    book.cancelOwnerOrders(command.mOwner);
+                    break;
+                case CommandType::EXPIRE:
+                    book.expireOrders(fromNanos(command.mTimestampNs));
+                    break;
+                case CommandType::START_AUCTION:
+                    book.startAuction();
+                    break;
+                case CommandType::UNCROSS_AUCTION:
+                    book.uncrossAuction(command.mPrice);
+                    break;
+                default:
+                    ++skipped;
+                    break;
+            }
+            auto t1 = Clock::now();
+            latency.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+
+            if (book.drainTrades(trades) > 0) {
+                hashTrades<Book>(trades, tradeHash);
+                if (!stores.empty()) {
+                    storeTrades<Book>(trades, command.mTimestampNs, *stores[command.mBook]);
+                }
+                tradeCount += trades.size();
+                trades.clear();
+            }
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+            DisarmAllocationCounter();
+#endif
+
+            if (conflator) {
+                for (size_t subscriber : {FAST_READER, SLOW_READER}) {
+                    if (subscriber == FAST_READER || commandIndex % options.mConflateEvery == 0) {
+                        depthUpdateCounts[subscriber] += conflator->Read(subscriber, depthUpdates);
+                        depthUpdates.clear();
+                    }
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // ==== Final book state: every level of every book, then every order ====
+        Hasher bookHash;
+        std::vector<Base::LevelInfo> levels;
+        for (const auto& book : books) {
+            for (Base::OrderSide side : {Base::OrderSide::BUY, Base::OrderSide::SELL}) {
+                levels.clear();
+                book->getLevels(side, levels);
+                bookHash.Add(levels.size());
+                for (const auto& level : levels) {
+                    bookHash.Add(level.mPrice);
+                    bookHash.Add(level.mQuantity);
+                    bookHash.Add(level.mOrderCount);
+                }
+            }
+        }
+        // Rolling checksums cover the resting orders only, read in O(1) per book
+        Hasher stateHash;
+        for (const auto& book : books) {
+            stateHash.Add(book->getChecksum());
+        }
+        for (Order& order : orders) {
+            bookHash.Add(order.GetId());
+            bookHash.Add(order.GetOpenQuantity());
+            bookHash.Add(static_cast<char>(order.GetOrderStatus()));
+        }
+
+        std::printf("commands     %zu (%llu skipped) over %zu books\n", log.size(),
+                    static_cast<unsigned long long>(skipped), books.size());
+        std::printf("throughput   %.0f commands/s (%.3fs)\n", log.size() / seconds, seconds);
+        std::printf("latency ns   p50=%llu p90=%llu p99=%llu p99.9=%llu p99.99=%llu\n",
+                    static_cast<unsigned long long>(latency.Percentile(0.50)),
+                    static_cast<unsigned long long>(latency.Percentile(0.90)),
+                    static_cast<unsigned long long>(latency.Percentile(0.99)),
+                    static_cast<unsigned long long>(latency.Percentile(0.999)),
+                    static_cast<unsigned long long>(latency.Percentile(0.9999)));
+        std::printf("trades       %llu\n", static_cast<unsigned long long>(tradeCount));
+        std::printf("trade hash   %016llx\n", static_cast<unsigned long long>(tradeHash.Get()));
+        std::printf("book hash    %016llx\n", static_cast<unsigned long long>(bookHash.Get()));
+        std::printf("state hash   %016llx\n", static_cast<unsigned long long>(stateHash.Get()));
+        if (conflator) {
+            // The slow reader's last batch is still pending, flush it so both end on the same state
+            depthUpdateCounts[SLOW_READER] += conflator->Read(SLOW_READER, depthUpdates);
+            std::printf("depth        fast reader %llu updates, every-%zu reader %llu updates (%llu conflated)\n",
+                        static_cast<unsigned long long>(depthUpdateCounts[FAST_READER]), options.mConflateEvery,
+                        static_cast<unsigned long long>(depthUpdateCounts[SLOW_READER]),
+                        static_cast<unsigned long long>(conflator->GetConflatedCount(SLOW_READER)));
+        }
+#ifdef ORDER_ENGINE_ALLOCATION_CHECK
+        uint64_t allocations = GetAllocationCount();
+        std::printf("allocations  %llu after %zu warm-up commands, %llu arena heap fallbacks\n",
+                    static_cast<unsigned long long>(allocations), options.mWarmup,
+                    static_cast<unsigned long long>(arena.GetHeapFallbacks()));
+        if (allocations != 0) {
+            std::fprintf(stderr, "FAILED: the hot path allocated\n");
+            return 4;
+        }
+#endif
+        return 0;
+    }
+
+    /**
+     * Synthetic flow for trying the tool without a capture: passive limit orders around a
+     * drifting mid, some crossing and market orders, cancels of earlier orders, and GTD orders
+     * expired by periodic expiry sweeps.
+     */
+    int generate(const std::string& path, size_t count, size_t bookCount, uint64_t seed)
+    {
+        CommandLogWriter writer(path);
+        for (size_t i = 0; i < bookCount; ++i) {
+            writer.AddBook("SYM" + std::to_string(i));
+        }
+
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> offset(-20, 20);
+        std::uniform_int_distribution<Base::Quantity> quantity(1, 500);
+        std::vector<std::vector<Base::OrderId>> live(bookCount);
+        std::vector<Base::Price> mid(bookCount, 10'000);
+        Base::OrderId nextId = 1;
+        const uint64_t startNs = 1'700'000'000'000'000'000ull;
+
+        for (size_t i = 0; i < count; ++i) {
+            Command command{};
+            command.mTimestampNs = startNs + i * 1'000;
+            command.mBook = static_cast<uint16_t>(rng() % bookCount);
+            auto& orderIds = live[command.mBook];
+            int roll = percent(rng);
+
+            if (roll < 2) {
+                command.mType = CommandType::EXPIRE;
+            }
+            else if (roll < 30 && !orderIds.empty()) {
+                size_t pick = rng() % orderIds.size();
+                command.mType = CommandType::CANCEL_ORDER;
+                command.mOrderId = orderIds[pick];
+                orderIds[pick] = orderIds.back();
+                orderIds.pop_back();
+            }
+            else {
+                Base::Price& bookMid = mid[command.mBook];
+                bookMid += offset(rng) / 10;
+                command.mType = CommandType::ADD_ORDER;
+                command.mOrderId = nextId++;
+                command.mOwner = 1 + rng() % 16;
+                command.mSide = (rng() & 1) ? Base::OrderSide::BUY : Base::OrderSide::SELL;
+                command.mQuantity = quantity(rng);
+                command.mTimeInForce = Base::TimeInForce::GTC;
+                bool isBuy = command.mSide == Base::OrderSide::BUY;
+
+                if (roll >= 97) {
+                    command.mOrderType = Base::OrderType::MARKET;
+                }
+                else {
+                    command.mOrderType = Base::OrderType::LIMIT;
+                    // Mostly passive, one in ten crosses the spread
+                    Base::Price spread = roll < 90 ? 2 + std::abs(offset(rng)) : -std::abs(offset(rng));
+                    command.mPrice = isBuy ? bookMid - spread : bookMid + spread;
+                    if (roll >= 95) {
+                        command.mConditions = Base::IMMEDIATE_OR_CANCEL;
+                    }
+                    else {
+                        if (roll >= 80 && roll < 90) {
+                            // Good for 1-100ms, i.e. 1k-100k commands
+                            command.mTimeInForce = Base::TimeInForce::GTD;
+                            command.mExpireTimeNs = command.mTimestampNs + (1 + rng() % 100) * 1'000'000;
+                        }
+                        orderIds.push_back(command.mOrderId);
+                    }
+                }
+            }
+            writer.Append(command);
+        }
+        if (!writer.Close()) {
+            std::fprintf(stderr, "writing %s failed: %s\n", path.c_str(), std::strerror(writer.GetError()));
+            return 1;
+        }
+        std::printf("wrote %zu commands over %zu books to %s\n", count, bookCount, path.c_str());
+        return 0;
+    }
+
+    // Range scan over a trade store: count, volume and VWAP of the trades in [fromNs, toNs]
+    int query(const std::string& path, int64_t fromNs, int64_t toNs)
+    {
+        TradeStoreReader store(path);
+
+        auto start = Clock::now();
+        uint64_t count = 0;
+        uint64_t volume = 0;
+        double notional = 0;
+        uint64_t visited = store.ScanBlocks(fromNs, toNs, [&](const TradeBlockView& view, size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row) {
+                bool inRange = view.mTimestamps[row] >= fromNs && view.mTimestamps[row] <= toNs;
+                count += inRange;
+                volume += inRange ? view.mQuantities[row] : 0;
+                notional += inRange ? static_cast<double>(view.mPrices[row]) * view.mQuantities[row] : 0;
+            }
+        });
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::printf("symbol       %s\n", store.GetSymbol().c_str());
+        std::printf("blocks       %llu of %llu visited\n", static_cast<unsigned long long>(visited),
+                    static_cast<unsigned long long>(store.GetBlockCount()));
+        std::printf("trades       %llu of %llu\n", static_cast<unsigned long long>(count),
+                    static_cast<unsigned long long>(store.GetRowCount()));
+        std::printf("volume       %llu\n", static_cast<unsigned long long>(volume));
+        std::printf("vwap         %.4f\n", volume != 0 ? notional / static_cast<double>(volume) : 0.0);
+        std::printf("scan         %.6fs\n", seconds);
+        return 0;
+    }
+
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: MatchingEngine_replay <log> [--policy fifo|prorata|toporder] [--store <dir>] [--conflate N] [--stats NAME] [--warmup N]\n"
+                     "       MatchingEngine_replay --generate <log> [--count N] [--books N] [--seed N]\n"
+                     "       MatchingEngine_replay --query <file> [--from NS] [--to NS]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    std::string policy = "fifo";
+    ReplayOptions options;
+    bool generateLog = false;
+    bool queryStore = false;
+    int64_t fromNs = INT64_MIN;
+    int64_t toNs = INT64_MAX;
+    size_t count = 1'000'000;
+    size_t bookCount = 4;
+    uint64_t seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--generate") == 0) {
+            generateLog = true;
+        }
+        else if (std::strcmp(argv[i], "--query") == 0) {
+            queryStore = true;
+        }
+        else if (std::strcmp(argv[i], "--store") == 0 && i + 1 < argc) {
+            options.mStoreDir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            fromNs = std::strtoll(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--to") == 0 && i + 1 < argc) {
+            toNs = std::strtoll(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--conflate") == 0 && i + 1 < argc) {
+            options.mConflateEvery = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+            options.mStatsSegment = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options.mWarmup = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            policy = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--books") == 0 && i + 1 < argc) {
+            bookCount = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            path = argv[i];
+        }
+    }
+    if (path.empty() || bookCount == 0 || bookCount > CommandLogHeader::kMaxBooks) {
+        return usage();
+    }
+
+    try {
+        if (generateLog) {
+            return generate(path, count, bookCount, seed);
+        }
+        if (queryStore) {
+            return query(path, fromNs, toNs);
+        }
+
+        CommandLogReader log(path);
+        if (policy == "fifo") {
+            return replay<FifoPolicy>(log, options);
+        }
+        if (policy == "prorata") {
+            return replay<ProRataPolicy>(log, options);
+        }
+        if (policy == "toporder") {
+            return replay<TopOrderProRataPolicy>(log, options);
+        }
+        return usage();
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}
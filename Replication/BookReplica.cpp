@@ -0,0 +1,152 @@
+#include "BookReplica.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace OrderEngine {
+
+    static Base::Timestamp fromNanos(uint64_t nanos)
+    {
+        return Base::Timestamp(std::chrono::duration_cast<Base::Timestamp::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    // FNV-1a, stable across platforms and builds
+    template<typename T> static void hashValue(uint64_t& hash, T value)
+    {
+        auto bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    }
+
+    template<typename MatchingPolicy> BookReplica<MatchingPolicy>::BookReplica(const std::vector<std::string>& symbols)
+        : mSymbols(symbols)
+    {
+        for (const std::string& symbol : mSymbols) {
+            mBooks.push_back(std::make_unique<Book>(symbol));
+        }
+        mTrades.reserve(1024);
+    }
+
+    template<typename MatchingPolicy> bool BookReplica<MatchingPolicy>::Apply(const Command& command)
+    {
+        if (command.mBook >= mBooks.size()) {
+            return false; // todo: log
+        }
+        Book& book = *mBooks[command.mBook];
+
+        switch (command.mType) {
+            case CommandType::ADD_ORDER: {
+                Order& order = newOrder(command);
+                order.SetType(command.mOrderType);
+                order.SetOwner(command.mOwner);
+                order.SetTimeInForce(command.mTimeInForce);
+                if (command.mExpireTimeNs != 0) {
+                    order.SetExpireTime(fromNanos(command.mExpireTimeNs));
+                }
+                // Expiry follows the primary's command clock, not this process's start time
+                book.startExpiryClock(fromNanos(command.mTimestampNs));
+                book.addOrder(&order, static_cast<Base::OrderConditions>(command.mConditions));
+                mLiveOrders.push_back({&order, command.mBook});
+                break;
+            }
+            case CommandType::CANCEL_ORDER:
+                book.cancelOrder(command.mOrderId);
+                break;
+            case CommandType::CANCEL_OWNER:
+                book.cancelOwnerOrders(command.mOwner);
+                break;
+            case CommandType::EXPIRE:
+                book.expireOrders(fromNanos(command.mTimestampNs));
+                break;
+            case CommandType::START_AUCTION:
+                book.startAuction();
+                break;
+            case CommandType::UNCROSS_AUCTION:
+                book.uncrossAuction(command.mPrice);
+                break;
+            default:
+                return false;
+        }
+
+        ++mApplied;
+        mTradeCount += book.drainTrades(mTrades);
+        mTrades.clear();
+        if (mLiveOrders.size() >= mSweepAt) {
+            sweepOrders();
+        }
+        return true;
+    }
+
+    template<typename MatchingPolicy> Order& BookReplica<MatchingPolicy>::newOrder(const Command& command)
+    {
+        Order order(command.mOrderId, mSymbols[command.mBook], command.mSide, command.mQuantity, command.mPrice,
+                    command.mStopPrice);
+        if (mFreeOrders.empty()) {
+            return mOrders.emplace_back(std::move(order));
+        }
+        Order* slot = mFreeOrders.back();
+        mFreeOrders.pop_back();
+        *slot = std::move(order);
+        return *slot;
+    }
+
+    /**
+     * @brief Recycles the slots of orders that left their book (filled, cancelled, expired, rejected).
+     * @details O(live orders), run once the live list has doubled since the last sweep, so O(1) per add.
+     */
+    template<typename MatchingPolicy> void BookReplica<MatchingPolicy>::sweepOrders()
+    {
+        size_t kept = 0;
+        for (const LiveOrder& live : mLiveOrders) {
+            if (mBooks[live.mBook]->holdsOrder(live.mOrder)) {
+                mLiveOrders[kept++] = live;
+            }
+            else {
+                mFreeOrders.push_back(live.mOrder);
+            }
+        }
+        mLiveOrders.resize(kept);
+        mSweepAt = std::max(kMinSweep, kept * 2);
+    }
+
+    template<typename MatchingPolicy> uint64_t BookReplica<MatchingPolicy>::GetChecksum() const
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        hashValue(hash, mTradeCount);
+        for (const auto& book : mBooks) {
+            hashValue(hash, book->getChecksum());
+        }
+        return hash;
+    }
+
+    template<typename MatchingPolicy> uint64_t BookReplica<MatchingPolicy>::GetAppliedCount() const
+    {
+        return mApplied;
+    }
+
+    template<typename MatchingPolicy> uint64_t BookReplica<MatchingPolicy>::GetTradeCount() const
+    {
+        return mTradeCount;
+    }
+
+    template<typename MatchingPolicy> size_t BookReplica<MatchingPolicy>::GetBookCount() const
+    {
+        return mBooks.size();
+    }
+
+    template<typename MatchingPolicy> size_t BookReplica<MatchingPolicy>::GetOrderSlotCount() const
+    {
+        return mOrders.size();
+    }
+
+    template<typename MatchingPolicy> typename BookReplica<MatchingPolicy>::Book& BookReplica<MatchingPolicy>::
+    GetBook(size_t index)
+    {
+        return *mBooks[index];
+    }
+
+    template class BookReplica<FifoPolicy>;
+    template class BookReplica<ProRataPolicy>;
+    template class BookReplica<TopOrderProRataPolicy>;
+} // namespace OrderEngine
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef BOOK_REPLICA_H
+#define BOOK_REPLICA_H
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Order.h"
+#include "../OrderBook/OrderBook.h"
+#include "../Protocol/Command.h"
+
+namespace OrderEngine {
+    /**
+     * @class BookReplica
+     * @brief A set of order books driven purely by a command stream.
+     *
+     * @details
+     * - Primary and standby both run one: applying the same commands in the same order gives the
+     *   same books, which is what makes the standby a warm copy.
+     * - Orders are built from the commands into stable slots, books hold raw pointers to them.
+     *   Once the live list doubles, one sweep asks each book which orders it still holds and
+     *   recycles the slots of the rest, so memory follows the resting orders, not the history.
+     * - Executions are drained after every command and only counted.
+     * - GetChecksum combines the rolling checksum of every book with the execution count, it
+     *   costs O(books) whatever the depth.
+     */
+    template<typename MatchingPolicy> class BookReplica
+    {
+    public:
+        using Book = OrderBook<Order*, MatchingPolicy>;
+
+        explicit BookReplica(const std::vector<std::string>& symbols);
+
+        // Applies one book command, false if it names an unknown book or is not a book command
+        bool Apply(const Command& command);
+
+        uint64_t GetChecksum() const;
+        uint64_t GetAppliedCount() const;
+        uint64_t GetTradeCount() const;
+        size_t GetBookCount() const;
+        Book& GetBook(size_t index);
+        // Order slots allocated so far, live or free
+        size_t GetOrderSlotCount() const;
+
+    private:
+        static constexpr size_t kMinSweep = 4096;
+
+        struct LiveOrder
+        {
+            Order* mOrder;
+            uint16_t mBook;
+        };
+
+        std::vector<std::string> mSymbols;
+        std::vector<std::unique_ptr<Book>> mBooks;
+        std::deque<Order> mOrders;              // Stable addresses, slots are reused
+        std::vector<LiveOrder> mLiveOrders;     // Orders a book may still hold
+        std::vector<Order*> mFreeOrders;        // Slots no book references any more
+        size_t mSweepAt = kMinSweep;
+        std::vector<typename Book::TradeExecution> mTrades;
+        uint64_t mApplied = 0;
+        uint64_t mTradeCount = 0;
+
+        Order& newOrder(const Command& command);
+        void sweepOrders();
+    };
+
+    extern template class BookReplica<FifoPolicy>;
+    extern template class BookReplica<ProRataPolicy>;
+    extern template class BookReplica<TopOrderProRataPolicy>;
+} // namespace OrderEngine
+
+#endif //BOOK_REPLICA_H
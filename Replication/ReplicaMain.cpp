@@ -0,0 +1,266 @@
+/**
+ * @file ReplicaMain.cpp
+ * @brief Primary/hot-standby pair over a shared memory replication channel.
+ *
+ * Usage:
+ *   MatchingEngine_replica --primary <log> [--segment NAME] [--checkpoint N] [--stall-ms N] [--policy fifo|prorata|toporder]
+ *   MatchingEngine_replica --standby [--segment NAME] [--policy fifo|prorata|toporder]
+ *
+ * The primary applies a command log to its books and publishes every command to the channel,
+ * with a book checksum every --checkpoint commands. The standby applies the same stream and
+ * verifies each checksum. When the primary stops or dies, the standby drains the ring and
+ * promotes itself; its final checksum matches the primary's last one.
+ *
+ * A standby that dies, or stalls a full ring for --stall-ms, is dropped: the primary finishes
+ * unreplicated and the standby, if it comes back, exits without promoting.
+ *
+ * Start the standby first (or within ten seconds), both sides must use the same policy.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BookReplica.h"
+#include "ReplicationChannel.h"
+#include "../Monitoring/LatencyHistogram.h"
+#include "../Protocol/CommandLog.h"
+
+namespace
+{
+    using namespace OrderEngine;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint64_t kAttachTimeoutMs = 10'000;
+
+    struct ReplicaOptions
+    {
+        std::string mLogPath;
+        std::string mSegment = "/MatchingEngine_replica";
+        uint64_t mInterval = 1'000;
+        uint64_t mStallTimeoutMs = ReplicationChannel::kDefaultStallTimeoutMs;
+    };
+
+    template<typename MatchingPolicy> int runPrimary(const ReplicaOptions& options)
+    {
+        const std::string& segment = options.mSegment;
+        const uint64_t interval = options.mInterval;
+        CommandLogReader log(options.mLogPath);
+        std::vector<std::string> symbols;
+        for (uint16_t i = 0; i < log.GetBookCount(); ++i) {
+            symbols.push_back(log.GetSymbol(i));
+        }
+
+        BookReplica<MatchingPolicy> replica(symbols);
+        ReplicationChannel channel = ReplicationChannel::Create(segment, symbols, options.mStallTimeoutMs);
+        if (!channel.WaitForStandby(kAttachTimeoutMs)) {
+            std::fprintf(stderr, "no standby attached to %s\n", segment.c_str());
+            return 1;
+        }
+
+        LatencyHistogram publishLatency;
+        uint64_t checksum = 0;
+        uint64_t checkpoints = 0;
+        bool takenOver = false;
+        uint64_t sequence = 0; // Input sequence of the command, record N of the log is N + 1
+        auto start = Clock::now();
+        for (const Command& command : log) {
+            ++sequence;
+            if (!replica.Apply(command)) {
+                continue;
+            }
+
+            auto t0 = Clock::now();
+            channel.Publish(command);
+            auto t1 = Clock::now();
+            publishLatency.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+
+            if (replica.GetAppliedCount() % interval == 0) {
+                checksum = replica.GetChecksum();
+                if (!channel.PublishCheckpoint(sequence, checksum)) {
+                    takenOver = true;
+                    break;
+                }
+                ++checkpoints;
+            }
+        }
+        if (!takenOver) {
+            checksum = replica.GetChecksum();
+            checkpoints += channel.PublishCheckpoint(sequence, checksum);
+            channel.MarkStopped();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // Give the standby time to verify the last checkpoint before the segment goes away
+        const ReplicationHeader& header = channel.GetHeader();
+        auto deadline = Clock::now() + std::chrono::milliseconds(kAttachTimeoutMs);
+        while (!takenOver && !channel.IsDegraded() && header.mCheckpointsVerified.load(std::memory_order_acquire) < checkpoints
+               && header.mDivergedAt.load(std::memory_order_acquire) == 0 && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::printf("role         primary%s\n",
+                    takenOver ? " (taken over)" : channel.IsDegraded() ? " (standby dropped, finished unreplicated)" : "");
+        std::printf("commands     %llu in %.3fs, %llu trades\n", static_cast<unsigned long long>(replica.GetAppliedCount()),
+                    seconds, static_cast<unsigned long long>(replica.GetTradeCount()));
+        std::printf("publish ns   p50=%llu p99=%llu p99.99=%llu, %llu stalls\n",
+                    static_cast<unsigned long long>(publishLatency.Percentile(0.50)),
+                    static_cast<unsigned long long>(publishLatency.Percentile(0.99)),
+                    static_cast<unsigned long long>(publishLatency.Percentile(0.9999)),
+                    static_cast<unsigned long long>(channel.GetStallCount()));
+        std::printf("checksum     %016llx\n", static_cast<unsigned long long>(checksum));
+        std::printf("verified     %llu of %llu checkpoints, diverged at %llu\n",
+                    static_cast<unsigned long long>(header.mCheckpointsVerified.load(std::memory_order_acquire)),
+                    static_cast<unsigned long long>(checkpoints),
+                    static_cast<unsigned long long>(header.mDivergedAt.load(std::memory_order_acquire)));
+        return header.mDivergedAt.load(std::memory_order_acquire) == 0 ? 0 : 3;
+    }
+
+    ReplicationChannel attachWithRetry(const std::string& segment)
+    {
+        auto deadline = Clock::now() + std::chrono::milliseconds(kAttachTimeoutMs);
+        while (true) {
+            try {
+                ReplicationChannel channel = ReplicationChannel::Attach(segment);
+                // A segment left behind by an earlier run is not a primary to follow
+                if (channel.IsPrimaryAlive()) {
+                    return channel;
+                }
+            }
+            catch (const std::exception&) {
+                if (Clock::now() > deadline) {
+                    throw;
+                }
+            }
+            if (Clock::now() > deadline) {
+                throw std::runtime_error("ReplicationChannel " + segment + ": no live primary");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    template<typename MatchingPolicy> int runStandby(const std::string& segment)
+    {
+        ReplicationChannel channel = attachWithRetry(segment);
+        BookReplica<MatchingPolicy> replica(channel.GetSymbols());
+        channel.MarkAttached();
+
+        uint64_t checkpoints = 0;
+        uint64_t mismatches = 0;
+        uint64_t idleSpins = 0;
+        bool draining = false;
+        Command command{};
+
+        while (true) {
+            if (channel.Poll(command)) {
+                idleSpins = 0;
+                if (command.mType == CommandType::CHECKPOINT) {
+                    ++checkpoints;
+                    mismatches += !channel.VerifyCheckpoint(command, replica.GetChecksum());
+                }
+                else if (replica.Apply(command)) {
+                    channel.ReportApplied(replica.GetAppliedCount());
+                }
+                continue;
+            }
+
+            if (draining) {
+                break; // Ring empty after the primary went away
+            }
+            // Liveness is only checked while idle, it costs a syscall
+            if (++idleSpins % 4096 == 0 && !channel.IsPrimaryAlive()) {
+                draining = true;
+            }
+        }
+
+        // Dropped while stalled, the stream has a gap and these books must not take over
+        if (channel.GetState() == ReplicationState::DEGRADED) {
+            std::printf("role         standby, dropped by the primary after %llu commands, not promoted\n",
+                        static_cast<unsigned long long>(replica.GetAppliedCount()));
+            return 4;
+        }
+
+        // ==== Failover: the books are already current, switching roles is all that is left ====
+        bool cleanStop = channel.GetState() == ReplicationState::STOPPED;
+        channel.Promote();
+
+        std::printf("role         standby, promoted after primary %s\n", cleanStop ? "stopped" : "failed");
+        std::printf("commands     %llu, %llu trades, %zu order slots\n", static_cast<unsigned long long>(replica.GetAppliedCount()),
+                    static_cast<unsigned long long>(replica.GetTradeCount()), replica.GetOrderSlotCount());
+        std::printf("checksum     %016llx\n", static_cast<unsigned long long>(replica.GetChecksum()));
+        std::printf("verified     %llu of %llu checkpoints\n", static_cast<unsigned long long>(checkpoints - mismatches),
+                    static_cast<unsigned long long>(checkpoints));
+        return mismatches == 0 ? 0 : 3;
+    }
+
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: MatchingEngine_replica --primary <log> [--segment NAME] [--checkpoint N] [--stall-ms N] [--policy fifo|prorata|toporder]\n"
+                     "       MatchingEngine_replica --standby [--segment NAME] [--policy fifo|prorata|toporder]\n");
+        return 2;
+    }
+
+    template<typename MatchingPolicy> int run(bool primary, const ReplicaOptions& options)
+    {
+        return primary ? runPrimary<MatchingPolicy>(options) : runStandby<MatchingPolicy>(options.mSegment);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ReplicaOptions options;
+    std::string policy = "fifo";
+    bool primary = false;
+    bool standby = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--primary") == 0 && i + 1 < argc) {
+            primary = true;
+            options.mLogPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--standby") == 0) {
+            standby = true;
+        }
+        else if (std::strcmp(argv[i], "--segment") == 0 && i + 1 < argc) {
+            options.mSegment = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            options.mInterval = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--stall-ms") == 0 && i + 1 < argc) {
+            options.mStallTimeoutMs = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            policy = argv[++i];
+        }
+        else {
+            return usage();
+        }
+    }
+    if (primary == standby || options.mInterval == 0) {
+        return usage();
+    }
+
+    try {
+        if (policy == "fifo") {
+            return run<FifoPolicy>(primary, options);
+        }
+        if (policy == "prorata") {
+            return run<ProRataPolicy>(primary, options);
+        }
+        if (policy == "toporder") {
+            return run<TopOrderProRataPolicy>(primary, options);
+        }
+        return usage();
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,295 @@
+#include "ReplicationChannel.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../Runtime/Cpu.h"
+
+namespace OrderEngine {
+
+    static constexpr size_t kRingOffset = (sizeof(ReplicationHeader) + 63) & ~size_t{63};
+    static constexpr size_t kSegmentSize = kRingOffset + sizeof(ReplicationRing);
+
+    static std::runtime_error channelError(const std::string& what, const std::string& name)
+    {
+        return std::runtime_error("ReplicationChannel " + name + ": " + what + " (" + std::strerror(errno) + ")");
+    }
+
+    ReplicationChannel ReplicationChannel::Create(const std::string& name, const std::vector<std::string>& symbols,
+                                                  uint64_t stallTimeoutMs)
+    {
+        if (symbols.size() > ReplicationHeader::kMaxBooks) {
+            throw std::runtime_error("ReplicationChannel " + name + ": too many books");
+        }
+
+        shm_unlink(name.c_str()); // Drop a leftover segment of a previous run
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            throw channelError("shm_open failed", name);
+        }
+        if (ftruncate(fd, static_cast<off_t>(kSegmentSize)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw channelError("ftruncate failed", name);
+        }
+
+        // Pre-faulted, the first pass over the ring must not fault on the primary
+        void* base = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            throw channelError("mmap failed", name);
+        }
+
+        auto* header = new (base) ReplicationHeader{};
+        header->mVersion = kReplicationVersion;
+        header->mBookCount = static_cast<uint32_t>(symbols.size());
+        header->mPrimaryPid = static_cast<uint64_t>(getpid());
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            std::strncpy(header->mSymbols[i], symbols[i].c_str(), ReplicationHeader::kSymbolSize - 1);
+        }
+        header->mState.store(static_cast<uint32_t>(ReplicationState::ACTIVE), std::memory_order_relaxed);
+        new (static_cast<char*>(base) + kRingOffset) ReplicationRing();
+        // Magic last: a standby that sees it sees an initialized segment
+        std::atomic_thread_fence(std::memory_order_release);
+        header->mMagic = kReplicationMagic;
+
+        return ReplicationChannel(base, kSegmentSize, name, true, stallTimeoutMs);
+    }
+
+    ReplicationChannel ReplicationChannel::Attach(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            throw channelError("shm_open failed", name);
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != kSegmentSize) {
+            close(fd);
+            throw std::runtime_error("ReplicationChannel " + name + ": unexpected segment size");
+        }
+
+        void* base = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            throw channelError("mmap failed", name);
+        }
+
+        ReplicationChannel channel(base, kSegmentSize, name, false);
+        const ReplicationHeader& header = channel.GetHeader();
+        if (header.mMagic != kReplicationMagic || header.mVersion != kReplicationVersion
+            || header.mBookCount > ReplicationHeader::kMaxBooks) {
+            throw std::runtime_error("ReplicationChannel " + name + ": unknown layout");
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return channel;
+    }
+
+    ReplicationChannel::ReplicationChannel(void* base, size_t size, std::string name, bool owner, uint64_t stallTimeoutMs)
+        : mBase(base), mSize(size), mName(std::move(name)), mOwner(owner),
+          mHeader(static_cast<ReplicationHeader*>(base)),
+          mRing(reinterpret_cast<ReplicationRing*>(static_cast<char*>(base) + kRingOffset)),
+          mStallTimeoutMs(stallTimeoutMs) {}
+
+    ReplicationChannel::ReplicationChannel(ReplicationChannel&& other) noexcept
+        : mBase(std::exchange(other.mBase, nullptr)),
+          mSize(std::exchange(other.mSize, 0)),
+          mName(std::move(other.mName)),
+          mOwner(std::exchange(other.mOwner, false)),
+          mHeader(std::exchange(other.mHeader, nullptr)),
+          mRing(std::exchange(other.mRing, nullptr)),
+          mStalls(std::exchange(other.mStalls, 0)),
+          mStallTimeoutMs(other.mStallTimeoutMs),
+          mDegraded(other.mDegraded) {}
+
+    ReplicationChannel& ReplicationChannel::operator=(ReplicationChannel&& other) noexcept
+    {
+        if (this != &other) {
+            this->~ReplicationChannel();
+            mBase = std::exchange(other.mBase, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+            mName = std::move(other.mName);
+            mOwner = std::exchange(other.mOwner, false);
+            mHeader = std::exchange(other.mHeader, nullptr);
+            mRing = std::exchange(other.mRing, nullptr);
+            mStalls = std::exchange(other.mStalls, 0);
+            mStallTimeoutMs = other.mStallTimeoutMs;
+            mDegraded = other.mDegraded;
+        }
+        return *this;
+    }
+
+    ReplicationChannel::~ReplicationChannel()
+    {
+        if (mBase) {
+            munmap(mBase, mSize);
+            mBase = nullptr;
+        }
+        if (mOwner) {
+            shm_unlink(mName.c_str());
+            mOwner = false;
+        }
+    }
+
+    std::vector<std::string> ReplicationChannel::GetSymbols() const
+    {
+        std::vector<std::string> symbols;
+        for (uint32_t i = 0; i < mHeader->mBookCount; ++i) {
+            symbols.emplace_back(mHeader->mSymbols[i], strnlen(mHeader->mSymbols[i], ReplicationHeader::kSymbolSize));
+        }
+        return symbols;
+    }
+
+    ReplicationState ReplicationChannel::GetState() const
+    {
+        return static_cast<ReplicationState>(mHeader->mState.load(std::memory_order_acquire));
+    }
+
+    // ==== Primary ====
+
+    /**
+     * @brief Slow path of Publish: the standby is a full ring behind.
+     * @details
+     * - A live standby is waited for rather than dropped, one with a gap in its command stream
+     *   could never be promoted.
+     * - Every kStallCheckSpins spins the standby is looked at: its process must still exist and
+     *   mStandbyApplied must have moved within the stall timeout. Otherwise the segment is marked
+     *   DEGRADED, and this command and every later one go unreplicated.
+     * - A standby that took over no longer drains either, the command is dropped and the caller
+     *   learns of it at its next checkpoint.
+     */
+    void ReplicationChannel::waitForSpace(const Command& command)
+    {
+        constexpr uint64_t kStallCheckSpins = 4096;
+
+        ++mStalls;
+        uint64_t applied = mHeader->mStandbyApplied.load(std::memory_order_acquire);
+        auto lastProgress = std::chrono::steady_clock::now();
+        for (uint64_t spins = 1; !mRing->TryPush(command); ++spins) {
+            CpuRelax();
+            if (spins % kStallCheckSpins != 0) {
+                continue;
+            }
+
+            if (GetState() != ReplicationState::ACTIVE) {
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            uint64_t nowApplied = mHeader->mStandbyApplied.load(std::memory_order_acquire);
+            if (nowApplied != applied) {
+                applied = nowApplied;
+                lastProgress = now;
+            }
+            else if (!isStandbyAlive() || now - lastProgress > std::chrono::milliseconds(mStallTimeoutMs)) {
+                mDegraded = true;
+                uint32_t active = static_cast<uint32_t>(ReplicationState::ACTIVE);
+                mHeader->mState.compare_exchange_strong(active, static_cast<uint32_t>(ReplicationState::DEGRADED),
+                                                        std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    bool ReplicationChannel::isStandbyAlive() const
+    {
+        auto pid = static_cast<pid_t>(mHeader->mStandbyPid.load(std::memory_order_acquire));
+        return pid == 0 || kill(pid, 0) == 0 || errno != ESRCH;
+    }
+
+    bool ReplicationChannel::PublishCheckpoint(uint64_t sequence, uint64_t checksum)
+    {
+        if (GetState() == ReplicationState::TAKEN_OVER) {
+            return false;
+        }
+
+        Command checkpoint{};
+        checkpoint.mType = CommandType::CHECKPOINT;
+        checkpoint.mOrderId = sequence;
+        checkpoint.mQuantity = checksum;
+        Publish(checkpoint);
+        return true;
+    }
+
+    bool ReplicationChannel::WaitForStandby(uint64_t timeoutMs) const
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (mHeader->mStandbyAttached.load(std::memory_order_acquire) == 0) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            usleep(1000);
+        }
+        return true;
+    }
+
+    void ReplicationChannel::MarkStopped()
+    {
+        uint32_t active = static_cast<uint32_t>(ReplicationState::ACTIVE);
+        mHeader->mState.compare_exchange_strong(active, static_cast<uint32_t>(ReplicationState::STOPPED),
+                                                std::memory_order_release);
+    }
+
+    uint64_t ReplicationChannel::GetStallCount() const
+    {
+        return mStalls;
+    }
+
+    bool ReplicationChannel::IsDegraded() const
+    {
+        return mDegraded;
+    }
+
+    // ==== Standby ====
+
+    void ReplicationChannel::MarkAttached()
+    {
+        mHeader->mStandbyPid.store(static_cast<uint64_t>(getpid()), std::memory_order_relaxed);
+        mHeader->mStandbyAttached.store(1, std::memory_order_release);
+    }
+
+    bool ReplicationChannel::VerifyCheckpoint(const Command& checkpoint, uint64_t localChecksum)
+    {
+        if (localChecksum == checkpoint.mQuantity) {
+            mHeader->mCheckpointsVerified.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        uint64_t none = 0;
+        mHeader->mDivergedAt.compare_exchange_strong(none, checkpoint.mOrderId, std::memory_order_release);
+        return false;
+    }
+
+    void ReplicationChannel::ReportApplied(uint64_t sequence)
+    {
+        mHeader->mStandbyApplied.store(sequence, std::memory_order_release);
+    }
+
+    bool ReplicationChannel::IsPrimaryAlive() const
+    {
+        if (GetState() != ReplicationState::ACTIVE) {
+            return false;
+        }
+        // A crashed primary never marks the segment, check its process
+        return kill(static_cast<pid_t>(mHeader->mPrimaryPid), 0) == 0 || errno != ESRCH;
+    }
+
+    void ReplicationChannel::Promote()
+    {
+        mHeader->mState.store(static_cast<uint32_t>(ReplicationState::TAKEN_OVER), std::memory_order_release);
+    }
+
+    const ReplicationHeader& ReplicationChannel::GetHeader() const
+    {
+        return *mHeader;
+    }
+} // namespace OrderEngine
@@ -0,0 +1,169 @@
+#pragma once
+#ifndef REPLICATION_CHANNEL_H
+#define REPLICATION_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Protocol/Command.h"
+#include "../Transport/SpscRing.h"
+
+namespace OrderEngine {
+    enum class ReplicationState : uint32_t
+    {
+        ACTIVE = 1,     // Primary is publishing
+        STOPPED = 2,    // Primary shut down cleanly, everything it published is in the ring
+        TAKEN_OVER = 3, // Standby promoted itself, the old primary must stop
+        DEGRADED = 4    // Primary gave up on a dead or stuck standby and matches unreplicated,
+                        // the standby has a gap and must not promote
+    };
+
+    /**
+     * @struct ReplicationHeader
+     * @brief Start of the replication segment, followed by the command ring.
+     * @details Primary-written and standby-written fields sit on separate cache lines.
+     */
+    struct alignas(64) ReplicationHeader
+    {
+        static constexpr size_t kMaxBooks = CommandLogHeader::kMaxBooks;
+        static constexpr size_t kSymbolSize = CommandLogHeader::kSymbolSize;
+
+        uint64_t mMagic;
+        uint32_t mVersion;
+        uint32_t mBookCount;
+        uint64_t mPrimaryPid;
+        std::atomic<uint32_t> mState;           // ReplicationState
+        char mSymbols[kMaxBooks][kSymbolSize];  // Command::mBook indexes this table
+
+        // Standby side
+        alignas(64) std::atomic<uint32_t> mStandbyAttached;
+        std::atomic<uint64_t> mStandbyPid;
+        std::atomic<uint64_t> mStandbyApplied;        // Commands applied by the standby, its heartbeat
+        std::atomic<uint64_t> mCheckpointsVerified;
+        std::atomic<uint64_t> mDivergedAt;            // Input sequence of the first mismatching checkpoint, 0 if none
+    };
+
+    static constexpr uint64_t kReplicationMagic = 0x314C504552454D45ull; // "EMEREPL1"
+    static constexpr uint32_t kReplicationVersion = 2;
+    static constexpr size_t kReplicationRingCapacity = size_t{1} << 16;
+
+    using ReplicationRing = SpscRing<Command, kReplicationRingCapacity>;
+
+    /**
+     * @class ReplicationChannel
+     * @brief Shared memory (/dev/shm) channel carrying the primary's sequenced commands to a hot standby.
+     *
+     * @details
+     * - The primary publishes every command it applies, in order, into an SpscRing. Publishing is
+     *   one 64 byte copy and a release store; it only waits when the standby is a full ring behind.
+     * - Every so often the primary publishes a CHECKPOINT command carrying its book checksum.
+     *   Checkpoints are in band, so the standby compares at exactly the same sequence and reports
+     *   the result back through the header.
+     * - A standby that stops draining a full ring, because its process died or it made no
+     *   progress for the stall timeout, is dropped: the primary marks the segment DEGRADED and
+     *   carries on without replication rather than block its matching thread.
+     * - Failover is a role switch: the standby drains the ring, marks the segment TAKEN_OVER and
+     *   carries on with books that are already up to date. An old primary still running sees the
+     *   mark at its next checkpoint.
+     * - Same layout rules as StatsSegment: fixed, versioned, rejected on mismatch.
+     */
+    class ReplicationChannel
+    {
+    public:
+        static constexpr uint64_t kDefaultStallTimeoutMs = 100;
+
+        /**
+         * @brief Creates (or replaces) the named segment with the book symbol table. Primary only.
+         * @param stallTimeoutMs How long a full ring may go without standby progress before it is dropped
+         * @throws std::runtime_error if the segment cannot be created or mapped, or there are too many books
+         */
+        static ReplicationChannel Create(const std::string& name, const std::vector<std::string>& symbols,
+                                         uint64_t stallTimeoutMs = kDefaultStallTimeoutMs);
+
+        /**
+         * @brief Attaches to a segment created by a primary. Standby only.
+         * @throws std::runtime_error if it does not exist or has an unexpected layout
+         */
+        static ReplicationChannel Attach(const std::string& name);
+
+        ReplicationChannel(ReplicationChannel&& other) noexcept;
+        ReplicationChannel& operator=(ReplicationChannel&& other) noexcept;
+        ReplicationChannel(const ReplicationChannel&) = delete;
+        ReplicationChannel& operator=(const ReplicationChannel&) = delete;
+        ~ReplicationChannel();
+
+        std::vector<std::string> GetSymbols() const;
+        ReplicationState GetState() const;
+
+        // ========== Primary ==========
+
+        // Copies one command into the ring, the primary's whole replication cost on the hot path
+        void Publish(const Command& command)
+        {
+            if (!mDegraded && !mRing->TryPush(command)) {
+                waitForSpace(command);
+            }
+        }
+
+        /**
+         * @brief Publishes the book checksum once the command of input sequence sequence is applied.
+         * @details The sequence is the journal's (record N of a command log is sequence N + 1), so a
+         *          divergence points straight at the command to look at.
+         * @return false if the standby has taken over, the primary must stop publishing
+         */
+        bool PublishCheckpoint(uint64_t sequence, uint64_t checksum);
+
+        // Spins until a standby attaches or the timeout passes, returns whether one did
+        bool WaitForStandby(uint64_t timeoutMs) const;
+
+        // Clean shutdown, the standby drains the ring and may promote itself
+        void MarkStopped();
+
+        // Publish calls that found the ring full
+        uint64_t GetStallCount() const;
+
+        // True once the standby was dropped, Publish is a no-op from then on
+        bool IsDegraded() const;
+
+        // ========== Standby ==========
+
+        void MarkAttached();
+
+        bool Poll(Command& command)
+        {
+            return mRing->TryPop(command);
+        }
+
+        // Compares the local checksum to a CHECKPOINT command and records the result in the header
+        bool VerifyCheckpoint(const Command& checkpoint, uint64_t localChecksum);
+
+        void ReportApplied(uint64_t sequence);
+
+        // False once the primary stopped, was taken over or its process is gone
+        bool IsPrimaryAlive() const;
+
+        // Marks the segment TAKEN_OVER, call after draining the ring
+        void Promote();
+
+        const ReplicationHeader& GetHeader() const;
+
+    private:
+        ReplicationChannel(void* base, size_t size, std::string name, bool owner, uint64_t stallTimeoutMs = 0);
+
+        void* mBase = nullptr;
+        size_t mSize = 0;
+        std::string mName;
+        bool mOwner = false; // Creator unlinks the segment on destruction
+        ReplicationHeader* mHeader = nullptr;
+        ReplicationRing* mRing = nullptr;
+        uint64_t mStalls = 0;
+        uint64_t mStallTimeoutMs = 0;
+        bool mDegraded = false;
+
+        void waitForSpace(const Command& command);
+        bool isStandbyAlive() const;
+    };
+} // namespace OrderEngine
+
+#endif //REPLICATION_CHANNEL_H
@@ -0,0 +1,127 @@
+#include "RiskGate.h"
+
+#include <algorithm>
+
+namespace OrderEngine {
+
+    RiskGate::RiskGate(const RiskConfig& config)
+        : mConfig(config), mAccounts(config.mMaxAccounts), mReferencePrices(config.mMaxBooks, 0)
+    {
+        for (AccountState& account : mAccounts) {
+            account.mLimits = config.mDefaultLimits;
+        }
+    }
+
+    void RiskGate::SetLimits(Base::OwnerId account, const RiskLimits& limits)
+    {
+        if (account >= mAccounts.size()) {
+            return; // todo: log
+        }
+        mAccounts[account].mLimits = limits;
+    }
+
+    void RiskGate::SetReferencePrice(uint16_t book, Base::Price price)
+    {
+        if (book < mReferencePrices.size()) {
+            mReferencePrices[book] = price;
+        }
+    }
+
+    RiskResult RiskGate::Check(const Command& command)
+    {
+        if (command.mOwner >= mAccounts.size()) {
+            return reject(RiskResult::UNKNOWN_ACCOUNT);
+        }
+        AccountState& account = mAccounts[command.mOwner];
+        const RiskLimits& limits = account.mLimits;
+
+        // ==== Message rate, fixed window on capture time ====
+        if (command.mTimestampNs - account.mWindowStartNs >= mConfig.mRateWindowNs) {
+            account.mWindowStartNs = command.mTimestampNs;
+            account.mMessages = 0;
+        }
+        if (++account.mMessages > limits.mMaxMessagesPerWindow) {
+            return reject(RiskResult::RATE_LIMIT);
+        }
+
+        if (command.mType != CommandType::ADD_ORDER) {
+            return RiskResult::ACCEPTED;
+        }
+
+        // ==== Order size ====
+        if (command.mQuantity > limits.mMaxOrderQuantity) {
+            return reject(RiskResult::MAX_QUANTITY);
+        }
+
+        Base::Price reference = command.mBook < mReferencePrices.size() ? mReferencePrices[command.mBook] : 0;
+        bool hasLimit = command.mOrderType != Base::OrderType::MARKET && command.mPrice > 0;
+        Base::Price checkPrice = hasLimit ? command.mPrice : reference;
+
+        uint64_t notional = 0;
+        if (checkPrice > 0 && __builtin_mul_overflow(static_cast<uint64_t>(checkPrice), command.mQuantity, &notional)) {
+            return reject(RiskResult::MAX_NOTIONAL);
+        }
+        if (notional > limits.mMaxOrderNotional) {
+            return reject(RiskResult::MAX_NOTIONAL);
+        }
+
+        // ==== Price collar ====
+        if (hasLimit && reference > 0) {
+            Base::Price distance = command.mPrice > reference ? command.mPrice - reference : reference - command.mPrice;
+            if (distance * 10'000 > reference * static_cast<Base::Price>(mConfig.mCollarBasisPoints)) {
+                return reject(RiskResult::PRICE_COLLAR);
+            }
+        }
+
+        // ==== Open exposure, only orders that can rest are booked ====
+        if (hasLimit) {
+            if (account.mOpenNotional + notional > limits.mMaxOpenNotional) {
+                return reject(RiskResult::EXPOSURE_LIMIT);
+            }
+            account.mOpenNotional += notional;
+        }
+        return RiskResult::ACCEPTED;
+    }
+
+    void RiskGate::Release(Base::OwnerId account, Base::Price limitPrice, Base::Quantity quantity)
+    {
+        if (account >= mAccounts.size() || limitPrice <= 0) {
+            return;
+        }
+        uint64_t notional = static_cast<uint64_t>(limitPrice) * quantity;
+        AccountState& state = mAccounts[account];
+        state.mOpenNotional -= std::min(state.mOpenNotional, notional);
+    }
+
+    uint64_t RiskGate::GetOpenNotional(Base::OwnerId account) const
+    {
+        return account < mAccounts.size() ? mAccounts[account].mOpenNotional : 0;
+    }
+
+    uint64_t RiskGate::GetRejectCount(RiskResult result) const
+    {
+        return mRejects[static_cast<size_t>(result)].load(std::memory_order_relaxed);
+    }
+
+    RiskResult RiskGate::reject(RiskResult result)
+    {
+        // Single writer, a plain load and store is enough
+        auto& counter = mRejects[static_cast<size_t>(result)];
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return result;
+    }
+
+    const char* RiskResultToString(RiskResult result)
+    {
+        switch (result) {
+            case RiskResult::ACCEPTED: return "accepted";
+            case RiskResult::UNKNOWN_ACCOUNT: return "unknown account";
+            case RiskResult::RATE_LIMIT: return "rate limit";
+            case RiskResult::MAX_QUANTITY: return "max quantity";
+            case RiskResult::MAX_NOTIONAL: return "max notional";
+            case RiskResult::PRICE_COLLAR: return "price collar";
+            case RiskResult::EXPOSURE_LIMIT: return "exposure limit";
+            default: return "unknown";
+        }
+    }
+} // namespace OrderEngine
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef RISK_GATE_H
+#define RISK_GATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../OrderTypes.h"
+#include "../Protocol/Command.h"
+
+namespace OrderEngine {
+    /**
+     * @brief Outcome of a pre-trade check, the first failed check wins.
+     */
+    enum class RiskResult : uint8_t
+    {
+        ACCEPTED = 0,
+        UNKNOWN_ACCOUNT,    // Owner id outside the configured account range
+        RATE_LIMIT,         // Too many messages from the account in the current window
+        MAX_QUANTITY,
+        MAX_NOTIONAL,
+        PRICE_COLLAR,       // Limit price too far from the book's reference price
+        EXPOSURE_LIMIT,     // Accepting the order would take the account's open notional over its limit
+        kResultCount
+    };
+
+    /**
+     * @struct RiskLimits
+     * @brief Per-account limits, notionals are price units times quantity.
+     */
+    struct RiskLimits
+    {
+        Base::Quantity mMaxOrderQuantity = 1'000'000;
+        uint64_t mMaxOrderNotional = 10'000'000'000ull;
+        uint64_t mMaxOpenNotional = 100'000'000'000ull;
+        uint32_t mMaxMessagesPerWindow = 100'000;
+    };
+
+    struct RiskConfig
+    {
+        uint32_t mMaxAccounts = 4096;   // Owner ids [0, mMaxAccounts) are known
+        uint16_t mMaxBooks = CommandLogHeader::kMaxBooks;
+        uint32_t mCollarBasisPoints = 500; // Allowed distance from the reference price
+        uint64_t mRateWindowNs = 1'000'000'000;
+        RiskLimits mDefaultLimits;
+    };
+
+    /**
+     * @class RiskGate
+     * @brief Pre-trade risk stage run on the inbound path before a command reaches its OrderBook.
+     *
+     * @details
+     * - Checks per order: message rate, max quantity, max notional, price collar around the
+     *   book's reference price (last trade or BBO, fed by the caller), open notional exposure.
+     * - State is flat arrays indexed by owner id and book index, owned by the single inbound
+     *   thread: no locks, no atomics read-modify-write, no allocation. A check is a handful of
+     *   loads, compares and stores.
+     * - Open exposure counts resting notional at the order's limit price. The caller releases
+     *   it from the order's fills and cancels with the same limit price, market orders are
+     *   checked at the reference price but never booked, they cannot rest.
+     * - Reject counters are relaxed atomics written by the gate only, monitoring may read them.
+     * - Times come from the command (capture time), the gate never reads a clock.
+     */
+    class RiskGate
+    {
+    public:
+        explicit RiskGate(const RiskConfig& config = RiskConfig{});
+
+        // Limits of one account, ignored for accounts outside the configured range
+        void SetLimits(Base::OwnerId account, const RiskLimits& limits);
+
+        // Collar reference of a book, 0 disables the collar until a price is known
+        void SetReferencePrice(uint16_t book, Base::Price price);
+
+        /**
+         * @brief Runs the checks for one inbound command.
+         * @details Every command counts against the rate limit; orders are checked in full and,
+         *          when accepted, their limit notional is added to the account's open exposure.
+         */
+        RiskResult Check(const Command& command);
+
+        // Gives back exposure of quantity at the order's limit price (fill, cancel, expiry, book reject)
+        void Release(Base::OwnerId account, Base::Price limitPrice, Base::Quantity quantity);
+
+        uint64_t GetOpenNotional(Base::OwnerId account) const;
+        uint64_t GetRejectCount(RiskResult result) const;
+
+    private:
+        struct alignas(64) AccountState
+        {
+            RiskLimits mLimits;
+            uint64_t mOpenNotional = 0;
+            uint64_t mWindowStartNs = 0;
+            uint32_t mMessages = 0;
+        };
+
+        RiskConfig mConfig;
+        std::vector<AccountState> mAccounts;
+        std::vector<Base::Price> mReferencePrices;
+        std::atomic<uint64_t> mRejects[static_cast<size_t>(RiskResult::kResultCount)] = {};
+
+        RiskResult reject(RiskResult result);
+    };
+
+    // Short name of a result for logs and reports
+    const char* RiskResultToString(RiskResult result);
+} // namespace OrderEngine
+
+#endif //RISK_GATE_H
@@ -0,0 +1,65 @@
+#include "Cpu.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace OrderEngine {
+
+    bool PinCurrentThread(int cpu)
+    {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    void SetCurrentThreadName(const std::string& name)
+    {
+#ifdef __linux__
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+        (void)name;
+#endif
+    }
+
+    std::vector<int> ParseCpuList(const std::string& list)
+    {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.empty() || range[0] < '0' || range[0] > '9') {
+                continue;
+            }
+            char* end = nullptr;
+            long first = std::strtol(range.c_str(), &end, 10);
+            long last = *end == '-' ? std::strtol(end + 1, nullptr, 10) : first;
+            for (long cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        return cpus;
+    }
+
+    std::vector<int> GetIsolatedCpus()
+    {
+        std::ifstream file("/sys/devices/system/cpu/isolated");
+        std::string list;
+        std::getline(file, list);
+        return ParseCpuList(list);
+    }
+} // namespace OrderEngine
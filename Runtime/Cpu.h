@@ -0,0 +1,35 @@
+#pragma once
+#ifndef RUNTIME_CPU_H
+#define RUNTIME_CPU_H
+
+#include <string>
+#include <vector>
+
+namespace OrderEngine {
+    // Spin-wait hint: lets the sibling hyperthread run and saves power without leaving the core
+    inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    /**
+     * @brief Pins the calling thread to one CPU.
+     * @return false if pinning is unsupported or was refused
+     */
+    bool PinCurrentThread(int cpu);
+
+    // Thread name shown by top/perf, truncated to 15 characters on Linux
+    void SetCurrentThreadName(const std::string& name);
+
+    // Parses a kernel CPU list such as "2-5,7", bad entries are skipped
+    std::vector<int> ParseCpuList(const std::string& list);
+
+    // CPUs removed from the scheduler with isolcpus, empty if none or unknown
+    std::vector<int> GetIsolatedCpus();
+} // namespace OrderEngine
+
+#endif //RUNTIME_CPU_H
@@ -0,0 +1,175 @@
+#include "Worker.h"
+#include "Cpu.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include <sched.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace OrderEngine {
+
+    static uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    double WorkerStats::GetDutyCycle() const
+    {
+        uint64_t busy = mBusyNs.load(std::memory_order_relaxed);
+        uint64_t total = busy + mIdleNs.load(std::memory_order_relaxed);
+        return total ? static_cast<double>(busy) / static_cast<double>(total) : 0.0;
+    }
+
+    Worker::Worker(WorkerConfig config, PollFn poll)
+        : mConfig(std::move(config)), mPoll(std::move(poll)) {}
+
+    Worker::~Worker()
+    {
+        RequestStop();
+        Join();
+    }
+
+    void Worker::Start()
+    {
+        mStopRequested.store(false, std::memory_order_relaxed);
+        mThread = std::thread(&Worker::run, this);
+    }
+
+    void Worker::RequestStop()
+    {
+        mStopRequested.store(true, std::memory_order_release);
+        wake(); // A parked worker would otherwise sleep out its timeout
+    }
+
+    void Worker::Join()
+    {
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+    const WorkerStats& Worker::GetStats() const
+    {
+        return mStats;
+    }
+
+    const WorkerConfig& Worker::GetConfig() const
+    {
+        return mConfig;
+    }
+
+    void Worker::run()
+    {
+        SetCurrentThreadName(mConfig.mName);
+        if (mConfig.mCpu >= 0) {
+            if (!PinCurrentThread(mConfig.mCpu)) {
+                std::fprintf(stderr, "%s: could not pin to cpu %d\n", mConfig.mName.c_str(), mConfig.mCpu);
+            }
+            auto isolated = GetIsolatedCpus();
+            if (mConfig.mRequireIsolatedCpu && std::find(isolated.begin(), isolated.end(), mConfig.mCpu) == isolated.end()) {
+                std::fprintf(stderr, "%s: cpu %d is not isolated (isolcpus), expect scheduler jitter\n",
+                             mConfig.mName.c_str(), mConfig.mCpu);
+            }
+        }
+
+        // Counters are single-writer, a local copy is stored back with plain relaxed stores
+        uint64_t busyNs = 0;
+        uint64_t idleNs = 0;
+        uint64_t workItems = 0;
+        uint64_t yields = 0;
+        uint64_t parks = 0;
+        uint32_t emptyPolls = 0;
+        uint64_t last = nowNs();
+
+        while (!mStopRequested.load(std::memory_order_acquire)) {
+            size_t done = mPoll();
+            uint64_t now = nowNs();
+
+            if (done > 0) {
+                busyNs += now - last;
+                workItems += done;
+                emptyPolls = 0;
+            }
+            else {
+                if (++emptyPolls < mConfig.mSpinPolls || mConfig.mWaitMode == WaitMode::BUSY_SPIN) {
+                    CpuRelax();
+                }
+                else if (mConfig.mWaitMode == WaitMode::SPIN_YIELD) {
+                    sched_yield();
+                    ++yields;
+                }
+                else {
+                    size_t lateWork = 0;
+                    parks += park(lateWork);
+                    workItems += lateWork;
+                    emptyPolls = 0;
+                }
+                now = nowNs();
+                idleNs += now - last;
+            }
+            last = now;
+
+            mStats.mBusyNs.store(busyNs, std::memory_order_relaxed);
+            mStats.mIdleNs.store(idleNs, std::memory_order_relaxed);
+            mStats.mWorkItems.store(workItems, std::memory_order_relaxed);
+            mStats.mYields.store(yields, std::memory_order_relaxed);
+            mStats.mParks.store(parks, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Sleeps until Notify() or the park timeout.
+     * @details The flag is raised before one last look for work; a producer that published
+     *          before the flag was visible is caught by that look, one that published after
+     *          sees the flag and bumps the epoch, which fails or ends the futex wait.
+     * @param lateWork Items handled by that last look
+     * @return true if the worker actually slept
+     */
+    bool Worker::park(size_t& lateWork)
+    {
+        uint32_t epoch = mWakeEpoch.load(std::memory_order_acquire);
+        mParked.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool slept = false;
+        if (!mStopRequested.load(std::memory_order_acquire) && (lateWork = mPoll()) == 0) {
+#ifdef __linux__
+            // tv_nsec must stay below one second, FUTEX_WAIT fails with EINVAL otherwise
+            timespec timeout{static_cast<time_t>(mConfig.mParkTimeoutUs / 1'000'000),
+                             static_cast<long>(mConfig.mParkTimeoutUs % 1'000'000) * 1000};
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mWakeEpoch), FUTEX_WAIT_PRIVATE, epoch, &timeout, nullptr, 0);
+#else
+            std::this_thread::sleep_for(std::chrono::microseconds(mConfig.mParkTimeoutUs));
+#endif
+            slept = true;
+        }
+        mParked.store(0, std::memory_order_relaxed);
+        return slept;
+    }
+
+    void Worker::wake()
+    {
+        mWakeEpoch.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mWakeEpoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+    const char* WaitModeToString(WaitMode mode)
+    {
+        switch (mode) {
+            case WaitMode::BUSY_SPIN: return "spin";
+            case WaitMode::SPIN_YIELD: return "yield";
+            case WaitMode::SPIN_PARK: return "park";
+            default: return "unknown";
+        }
+    }
+} // namespace OrderEngine
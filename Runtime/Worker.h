@@ -0,0 +1,112 @@
+#pragma once
+#ifndef RUNTIME_WORKER_H
+#define RUNTIME_WORKER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace OrderEngine {
+    /**
+     * @brief What a worker does when a poll finds no work.
+     */
+    enum class WaitMode : uint8_t
+    {
+        BUSY_SPIN,  // pause and poll again, lowest latency, owns the core
+        SPIN_YIELD, // spin for a while, then sched_yield between polls
+        SPIN_PARK   // spin for a while, then sleep on a futex until notified
+    };
+
+    struct WorkerConfig
+    {
+        std::string mName = "engine";
+        int mCpu = -1;                      // CPU to pin to, -1 leaves the thread unpinned
+        bool mRequireIsolatedCpu = false;   // Warn when mCpu is not in the isolcpus set
+        WaitMode mWaitMode = WaitMode::BUSY_SPIN;
+        uint32_t mSpinPolls = 10'000;       // Empty polls before yielding/parking
+        uint32_t mParkTimeoutUs = 1'000;    // Upper bound of one park, also covers a missed notify
+    };
+
+    /**
+     * @struct WorkerStats
+     * @brief Duty-cycle accounting of one worker, written by the worker only, readable from any thread.
+     * @details Time is split at every poll: polls that did work count as busy, everything else
+     *          (empty polls, spinning, yields, parks) as idle.
+     */
+    struct WorkerStats
+    {
+        std::atomic<uint64_t> mBusyNs{0};
+        std::atomic<uint64_t> mIdleNs{0};
+        std::atomic<uint64_t> mWorkItems{0};
+        std::atomic<uint64_t> mYields{0};
+        std::atomic<uint64_t> mParks{0};
+
+        // Busy share of the worker's time, 0 before it ran
+        double GetDutyCycle() const;
+    };
+
+    /**
+     * @class Worker
+     * @brief Dedicated thread driving one shard: polls its inbound rings and books in a loop.
+     *
+     * @details
+     * - The poll function processes whatever is pending and returns how many items it handled.
+     *   It runs on the worker thread only, so everything it touches can stay single-threaded.
+     * - Idle handling is the wait mode: latency-critical shards busy-spin on their own core,
+     *   quiet shards yield or park and give the core back.
+     * - Producers call Notify() after publishing work. It costs a fence and a load unless the
+     *   worker is parked, and nothing at all in the spinning modes.
+     */
+    class Worker
+    {
+    public:
+        using PollFn = std::function<size_t()>;
+
+        Worker(WorkerConfig config, PollFn poll);
+        ~Worker();
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        void Start();
+
+        // Asks the loop to exit after its current poll, Join() waits for it
+        void RequestStop();
+        void Join();
+
+        void Notify()
+        {
+            if (mConfig.mWaitMode != WaitMode::SPIN_PARK) {
+                return;
+            }
+            // Pairs with the fence in park(): either the worker sees the new work or we see it parked
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mParked.load(std::memory_order_relaxed)) {
+                wake();
+            }
+        }
+
+        const WorkerStats& GetStats() const;
+        const WorkerConfig& GetConfig() const;
+
+    private:
+        WorkerConfig mConfig;
+        PollFn mPoll;
+        std::thread mThread;
+        WorkerStats mStats;
+        std::atomic<bool> mStopRequested{false};
+
+        // Park state, on its own line: producers read it on every Notify
+        alignas(64) std::atomic<uint32_t> mParked{0};
+        std::atomic<uint32_t> mWakeEpoch{0};
+
+        void run();
+        bool park(size_t& lateWork);
+        void wake();
+    };
+
+    const char* WaitModeToString(WaitMode mode);
+} // namespace OrderEngine
+
+#endif //RUNTIME_WORKER_H
@@ -0,0 +1,684 @@
+#include "DropCopyWriter.h"
+#include "../Runtime/Cpu.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef ORDER_ENGINE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace OrderEngine {
+
+    static constexpr size_t kPageBytes = 4096;
+    static constexpr size_t kMaxBatches = 32;
+    static constexpr unsigned kIoQueueDepth = 64;       // One request per batch plus a sync always fit
+    static constexpr size_t kMaxRecordBytes = 256;      // Longest CSV line, a batch always keeps this much free
+    static constexpr size_t kDrainPerPoll = 4096;       // Reports encoded before completions are looked at again
+    static constexpr uint32_t kSyncTag = UINT32_MAX;
+    static_assert(kMaxBatches + 1 <= kIoQueueDepth, "Requests in flight must fit the I/O queues");
+
+    static const char kCsvHeader[] = "send_ns,book,exec_id,exec_type,order_id,contra_order_id,side,price,last_qty,leaves_qty,status\n";
+
+    static uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Counters have a single writer, a relaxed load and store is enough
+    static void bump(std::atomic<uint64_t>& counter, uint64_t by = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static std::runtime_error dropCopyError(const std::string& what, const std::string& path)
+    {
+        return std::runtime_error("DropCopy " + path + ": " + what + " (" + std::strerror(errno) + ")");
+    }
+
+    // ==== CSV encoding, no allocation and no locale ====
+
+    static char* appendUnsigned(char* out, uint64_t value)
+    {
+        char digits[20];
+        size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count != 0) {
+            *out++ = digits[--count];
+        }
+        return out;
+    }
+
+    static char* appendSigned(char* out, int64_t value)
+    {
+        if (value < 0) {
+            *out++ = '-';
+            return appendUnsigned(out, 0 - static_cast<uint64_t>(value));
+        }
+        return appendUnsigned(out, static_cast<uint64_t>(value));
+    }
+
+    // Enum fields are FIX-style characters, a zeroed field stays empty
+    template<typename Enum> static char* appendCode(char* out, Enum value)
+    {
+        if (static_cast<char>(value) != 0) {
+            *out++ = static_cast<char>(value);
+        }
+        return out;
+    }
+
+    static size_t formatCsv(const ExecutionReport& report, char* line)
+    {
+        char* out = line;
+        out = appendUnsigned(out, report.mSendTimestampNs);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mBook);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mExecId);
+        *out++ = ',';
+        out = appendCode(out, report.mExecType);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mOrderId);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mContraOrderId);
+        *out++ = ',';
+        out = appendCode(out, report.mSide);
+        *out++ = ',';
+        out = appendSigned(out, report.mPrice);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mLastQuantity);
+        *out++ = ',';
+        out = appendUnsigned(out, report.mLeavesQuantity);
+        *out++ = ',';
+        out = appendCode(out, report.mStatus);
+        *out++ = '\n';
+        return static_cast<size_t>(out - line);
+    }
+
+    // ==== I/O backends ====
+
+    // Result of one request: bytes written or 0 for a sync, -errno on failure
+    struct IoCompletion
+    {
+        uint32_t mTag; // Batch index, kSyncTag for a sync
+        int64_t mResult;
+    };
+
+    /**
+     * Asynchronous writes and syncs of one file. Requests may complete in any order, except that
+     * a sync starts only after every write submitted before it has completed.
+     */
+    class DropCopyWriter::IoBackend
+    {
+    public:
+        virtual ~IoBackend() = default;
+
+        // Both return false, nothing submitted, if the request queue is full
+        virtual bool SubmitWrite(uint32_t tag, const char* data, size_t length, uint64_t offset) = 0;
+        virtual bool SubmitSync() = 0;
+
+        // Never blocks, returns the number of completions stored
+        virtual size_t Reap(IoCompletion* completions, size_t max) = 0;
+    };
+
+#ifdef ORDER_ENGINE_IO_URING
+    /**
+     * io_uring driven through its raw syscalls, liburing is not needed. A sync is flagged
+     * IOSQE_IO_DRAIN, so the kernel holds it back until every earlier write is done.
+     */
+    class DropCopyWriter::UringBackend : public IoBackend
+    {
+    public:
+        UringBackend(int fd, unsigned entries)
+            : mFd(fd)
+        {
+            io_uring_params params{};
+            mRingFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (mRingFd < 0) {
+                return; // Old kernel, seccomp or io_uring_disabled, the caller falls back
+            }
+
+            mSqBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            mCqBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (singleMap) {
+                mSqBytes = mCqBytes = std::max(mSqBytes, mCqBytes);
+            }
+            mSqRing = mapRing(mSqBytes, IORING_OFF_SQ_RING);
+            mCqRing = singleMap ? mSqRing : mapRing(mCqBytes, IORING_OFF_CQ_RING);
+            mSqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = mapRing(mSqesBytes, IORING_OFF_SQES);
+            if (!mSqRing || !mCqRing || !sqes) {
+                if (sqes) {
+                    munmap(sqes, mSqesBytes);
+                }
+                release();
+                return;
+            }
+
+            auto* sq = static_cast<char*>(mSqRing);
+            mSqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            mSqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            mSqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            mSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            mSqEntries = params.sq_entries;
+            auto* cq = static_cast<char*>(mCqRing);
+            mCqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            mCqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            mCqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            mCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            mSqes = static_cast<io_uring_sqe*>(sqes);
+        }
+
+        ~UringBackend() override
+        {
+            if (mSqes) {
+                munmap(mSqes, mSqesBytes);
+            }
+            release();
+        }
+
+        bool IsValid() const
+        {
+            return mSqes != nullptr;
+        }
+
+        bool SubmitWrite(uint32_t tag, const char* data, size_t length, uint64_t offset) override
+        {
+            io_uring_sqe* sqe = nextSqe();
+            if (!sqe) {
+                return false;
+            }
+            sqe->opcode = IORING_OP_WRITE;
+            sqe->fd = mFd;
+            sqe->addr = reinterpret_cast<uint64_t>(data);
+            sqe->len = static_cast<uint32_t>(length);
+            sqe->off = offset;
+            sqe->user_data = tag;
+            submit();
+            return true;
+        }
+
+        bool SubmitSync() override
+        {
+            io_uring_sqe* sqe = nextSqe();
+            if (!sqe) {
+                return false;
+            }
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fd = mFd;
+            sqe->flags = IOSQE_IO_DRAIN;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            sqe->user_data = kSyncTag;
+            submit();
+            return true;
+        }
+
+        size_t Reap(IoCompletion* completions, size_t max) override
+        {
+            // Entries a failed io_uring_enter left behind go in with the next poll
+            if (*mSqTail != __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE)) {
+                enter(*mSqTail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE));
+            }
+
+            unsigned head = *mCqHead;
+            unsigned tail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+            size_t count = 0;
+            for (; head != tail && count < max; ++head, ++count) {
+                const io_uring_cqe& cqe = mCqes[head & mCqMask];
+                completions[count] = {static_cast<uint32_t>(cqe.user_data), cqe.res};
+            }
+            __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+            return count;
+        }
+
+    private:
+        int mFd;
+        int mRingFd = -1;
+        void* mSqRing = nullptr;
+        void* mCqRing = nullptr;
+        size_t mSqBytes = 0;
+        size_t mCqBytes = 0;
+        size_t mSqesBytes = 0;
+        unsigned* mSqHead = nullptr;
+        unsigned* mSqTail = nullptr;
+        unsigned* mSqArray = nullptr;
+        unsigned mSqMask = 0;
+        unsigned mSqEntries = 0;
+        unsigned* mCqHead = nullptr;
+        unsigned* mCqTail = nullptr;
+        unsigned mCqMask = 0;
+        io_uring_cqe* mCqes = nullptr;
+        io_uring_sqe* mSqes = nullptr;
+
+        void* mapRing(size_t bytes, off_t offset) const
+        {
+            void* ring = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, offset);
+            return ring == MAP_FAILED ? nullptr : ring;
+        }
+
+        void release()
+        {
+            if (mCqRing && mCqRing != mSqRing) {
+                munmap(mCqRing, mCqBytes);
+            }
+            if (mSqRing) {
+                munmap(mSqRing, mSqBytes);
+            }
+            if (mRingFd >= 0) {
+                close(mRingFd);
+            }
+            mSqRing = mCqRing = nullptr;
+            mRingFd = -1;
+        }
+
+        io_uring_sqe* nextSqe()
+        {
+            unsigned tail = *mSqTail;
+            if (tail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) == mSqEntries) {
+                return nullptr;
+            }
+            io_uring_sqe* sqe = &mSqes[tail & mSqMask];
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        void submit()
+        {
+            unsigned tail = *mSqTail;
+            mSqArray[tail & mSqMask] = tail & mSqMask;
+            __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+            // One syscall per request: a request is a whole batch, the cost is paid per megabyte
+            enter(1);
+        }
+
+        void enter(unsigned toSubmit)
+        {
+            syscall(__NR_io_uring_enter, mRingFd, toSubmit, 0, 0, nullptr, 0);
+        }
+    };
+#endif
+
+    /**
+     * Fallback: a second worker takes the requests in order and issues blocking pwrite and
+     * fdatasync calls, a sync therefore also follows every write queued before it.
+     */
+    class DropCopyWriter::PwriteBackend : public IoBackend
+    {
+    public:
+        PwriteBackend(int fd, const WorkerConfig& writerConfig)
+            : mFd(fd)
+        {
+            // Left unpinned: it spends its time blocked in the kernel, not polling
+            WorkerConfig config = writerConfig;
+            config.mName = writerConfig.mName + "-io";
+            config.mCpu = -1;
+            config.mWaitMode = WaitMode::SPIN_PARK;
+            mWorker = std::make_unique<Worker>(config, [this] { return poll(); });
+            mWorker->Start();
+        }
+
+        bool SubmitWrite(uint32_t tag, const char* data, size_t length, uint64_t offset) override
+        {
+            if (!mRequests.TryPush({tag, data, length, offset})) {
+                return false;
+            }
+            mWorker->Notify();
+            return true;
+        }
+
+        bool SubmitSync() override
+        {
+            if (!mRequests.TryPush({kSyncTag, nullptr, 0, 0})) {
+                return false;
+            }
+            mWorker->Notify();
+            return true;
+        }
+
+        size_t Reap(IoCompletion* completions, size_t max) override
+        {
+            size_t count = 0;
+            while (count < max && mCompletions.TryPop(completions[count])) {
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        struct Request
+        {
+            uint32_t mTag;
+            const char* mData;
+            size_t mLength;
+            uint64_t mOffset;
+        };
+
+        int mFd;
+        SpscRing<Request, kIoQueueDepth> mRequests;
+        SpscRing<IoCompletion, kIoQueueDepth> mCompletions;
+        std::unique_ptr<Worker> mWorker; // Last, stopped before the rings go away
+
+        size_t poll()
+        {
+            Request request;
+            if (!mRequests.TryPop(request)) {
+                return 0;
+            }
+            IoCompletion completion{request.mTag, 0};
+            if (request.mTag == kSyncTag) {
+                completion.mResult = fdatasync(mFd) == 0 ? 0 : -errno;
+            }
+            else {
+                ssize_t written = pwrite(mFd, request.mData, request.mLength, static_cast<off_t>(request.mOffset));
+                completion.mResult = written >= 0 ? written : -errno;
+            }
+            // Cannot be full, it never holds more than the requests in flight
+            mCompletions.TryPush(completion);
+            return 1;
+        }
+    };
+
+    // ==== Writer ====
+
+    DropCopyWriter::DropCopyWriter(const std::string& path, const DropCopyConfig& config)
+        : mPath(path), mConfig(config), mQueue(std::make_unique<SpscRing<ExecutionReport, kQueueCapacity>>())
+    {
+        mConfig.mBufferCount = std::clamp<size_t>(mConfig.mBufferCount, 2, kMaxBatches);
+        mConfig.mBufferBytes = std::max(kPageBytes, (mConfig.mBufferBytes + kPageBytes - 1) / kPageBytes * kPageBytes);
+
+        mFd = open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (mFd < 0) {
+            throw dropCopyError("open failed", path);
+        }
+        // Reopening continues after the last record
+        off_t end = lseek(mFd, 0, SEEK_END);
+        mFileOffset = end > 0 ? static_cast<uint64_t>(end) : 0;
+        mStats.mSyncedBytes.store(mFileOffset, std::memory_order_relaxed);
+
+        mBufferMemory = static_cast<char*>(std::aligned_alloc(kPageBytes, mConfig.mBufferBytes * mConfig.mBufferCount));
+        if (!mBufferMemory) {
+            close(mFd);
+            throw dropCopyError("buffer allocation failed", path);
+        }
+        mBatches.resize(mConfig.mBufferCount);
+        mFreeBatches.reserve(mConfig.mBufferCount);
+        for (size_t i = mConfig.mBufferCount; i-- > 0;) {
+            mBatches[i].mData = mBufferMemory + i * mConfig.mBufferBytes;
+            mFreeBatches.push_back(static_cast<uint32_t>(i));
+        }
+
+#ifdef ORDER_ENGINE_IO_URING
+        if (mConfig.mUseIoUring) {
+            auto uring = std::make_unique<UringBackend>(mFd, kIoQueueDepth);
+            if (uring->IsValid()) {
+                mBackend = std::move(uring);
+                mUsingIoUring = true;
+            }
+        }
+#endif
+        if (!mBackend) {
+            mBackend = std::make_unique<PwriteBackend>(mFd, mConfig.mWorker);
+        }
+
+        if (mConfig.mFormat == DropCopyFormat::CSV && mFileOffset == 0) {
+            ensureRoom();
+            Batch& batch = mBatches[mCurrent];
+            std::memcpy(batch.mData, kCsvHeader, sizeof(kCsvHeader) - 1);
+            batch.mLength = sizeof(kCsvHeader) - 1;
+            mCurrentStartNs = nowNs();
+        }
+
+        mLastSyncNs = nowNs();
+        mWorker = std::make_unique<Worker>(mConfig.mWorker, [this] { return poll(false); });
+        mWorker->Start();
+    }
+
+    DropCopyWriter::~DropCopyWriter()
+    {
+        Close();
+        mBackend.reset();
+        std::free(mBufferMemory);
+        close(mFd);
+    }
+
+    void DropCopyWriter::Close()
+    {
+        if (mClosed) {
+            return;
+        }
+        mClosed = true;
+        mWorker->RequestStop();
+        mWorker->Join();
+
+        // The writer thread is gone, its remaining work is finished here: the queue, the partial batch, a last sync
+        for (;;) {
+            bool pendingBatch = mCurrent != kNoBatch && mBatches[mCurrent].mLength > 0;
+            if (mQueue->Size() == 0 && !pendingBatch && mWritesInFlight == 0 && !mSyncInFlight && !mUnsynced) {
+                break;
+            }
+            if (poll(true) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool DropCopyWriter::IsUsingIoUring() const
+    {
+        return mUsingIoUring;
+    }
+
+    const DropCopyStats& DropCopyWriter::GetStats() const
+    {
+        return mStats;
+    }
+
+    bool DropCopyWriter::IsFailed() const
+    {
+        return GetError() != 0;
+    }
+
+    int DropCopyWriter::GetError() const
+    {
+        return mError.load(std::memory_order_relaxed);
+    }
+
+    size_t DropCopyWriter::poll(bool closing)
+    {
+        size_t done = reap();
+        if (IsFailed()) {
+            return done + discard();
+        }
+
+        ExecutionReport report;
+        for (size_t i = 0; i < kDrainPerPoll && ensureRoom() && mQueue->TryPop(report); ++i) {
+            encode(report);
+            ++done;
+        }
+
+        uint64_t now = nowNs();
+        if (mCurrent != kNoBatch && mBatches[mCurrent].mLength > 0
+            && (closing || now - mCurrentStartNs >= mConfig.mFlushIntervalNs)) {
+            submitCurrent();
+        }
+        maybeSync(now, closing);
+        return done;
+    }
+
+    size_t DropCopyWriter::reap()
+    {
+        IoCompletion completions[kIoQueueDepth];
+        size_t count = mBackend->Reap(completions, std::size(completions));
+
+        for (size_t i = 0; i < count; ++i) {
+            const IoCompletion& completion = completions[i];
+            if (completion.mTag == kSyncTag) {
+                mSyncInFlight = false;
+                if (completion.mResult < 0) {
+                    // Pages that failed writeback may already be marked clean, a later sync would
+                    // not cover them again: the durability of the file is unknown from here on
+                    bump(mStats.mErrors);
+                    fail(static_cast<int>(-completion.mResult));
+                }
+                else {
+                    bump(mStats.mSyncs);
+                    mStats.mSyncedBytes.store(std::min(mSyncOffset, mTruncateAt), std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            Batch& batch = mBatches[completion.mTag];
+            --mWritesInFlight;
+            bool retry = completion.mResult == -EINTR || completion.mResult == -EAGAIN;
+            if (retry && !IsFailed()) {
+                submitWrite(completion.mTag);
+                continue;
+            }
+            if (completion.mResult <= 0 && !retry) {
+                // ENOSPC, EIO...: the batch cannot be written, later ones must not land past a hole
+                bump(mStats.mErrors);
+                mTruncateAt = std::min(mTruncateAt, batch.mOffset);
+                fail(completion.mResult < 0 ? static_cast<int>(-completion.mResult) : EIO);
+            }
+            else if (completion.mResult > 0) {
+                batch.mWritten += static_cast<size_t>(completion.mResult);
+                bump(mStats.mBytesWritten, static_cast<uint64_t>(completion.mResult));
+                if (batch.mWritten < batch.mLength && !IsFailed()) {
+                    submitWrite(completion.mTag); // Short write, the rest goes again
+                    continue;
+                }
+            }
+            batch.mLength = 0;
+            mFreeBatches.push_back(completion.mTag);
+        }
+        return count;
+    }
+
+    bool DropCopyWriter::ensureRoom()
+    {
+        if (mCurrent != kNoBatch) {
+            if (mConfig.mBufferBytes - mBatches[mCurrent].mLength >= kMaxRecordBytes) {
+                return true;
+            }
+            submitCurrent();
+        }
+        if (mFreeBatches.empty()) {
+            return false; // Every batch is with the disk, the queue absorbs the wait
+        }
+        mCurrent = mFreeBatches.back();
+        mFreeBatches.pop_back();
+        return true;
+    }
+
+    void DropCopyWriter::encode(const ExecutionReport& report)
+    {
+        Batch& batch = mBatches[mCurrent];
+        if (batch.mLength == 0) {
+            mCurrentStartNs = nowNs();
+        }
+        if (mConfig.mFormat == DropCopyFormat::BINARY) {
+            std::memcpy(batch.mData + batch.mLength, &report, sizeof(report));
+            batch.mLength += sizeof(report);
+        }
+        else {
+            batch.mLength += formatCsv(report, batch.mData + batch.mLength);
+        }
+        bump(mStats.mRecords);
+    }
+
+    void DropCopyWriter::submitCurrent()
+    {
+        Batch& batch = mBatches[mCurrent];
+        batch.mOffset = mFileOffset;
+        batch.mWritten = 0;
+        mFileOffset += batch.mLength;
+        submitWrite(mCurrent);
+        mCurrent = kNoBatch;
+        bump(mStats.mBatches);
+    }
+
+    void DropCopyWriter::submitWrite(uint32_t index)
+    {
+        const Batch& batch = mBatches[index];
+        // The queues hold every batch at once, this only spins if the kernel stopped taking requests
+        while (!mBackend->SubmitWrite(index, batch.mData + batch.mWritten, batch.mLength - batch.mWritten,
+                                      batch.mOffset + batch.mWritten)) {
+            CpuRelax();
+        }
+        ++mWritesInFlight;
+        mUnsynced = true;
+    }
+
+    void DropCopyWriter::maybeSync(uint64_t now, bool force)
+    {
+        if (!mUnsynced || mSyncInFlight) {
+            return;
+        }
+        if (!force && mConfig.mFsyncIntervalNs != 0 && now - mLastSyncNs < mConfig.mFsyncIntervalNs) {
+            return;
+        }
+        if (!mBackend->SubmitSync()) {
+            return; // Queue full, the next poll tries again
+        }
+        mSyncOffset = mFileOffset;
+        mSyncInFlight = true;
+        mUnsynced = false;
+        mLastSyncNs = now;
+    }
+
+    /**
+     * @brief Puts the writer in its failed state, the first error is the one reported.
+     * @details Producers see it on their next Publish. The batch being filled is dropped.
+     */
+    void DropCopyWriter::fail(int error)
+    {
+        int none = 0;
+        mError.compare_exchange_strong(none, error, std::memory_order_relaxed);
+        if (mCurrent != kNoBatch) {
+            mBatches[mCurrent].mLength = 0;
+            mFreeBatches.push_back(mCurrent);
+            mCurrent = kNoBatch;
+        }
+        mUnsynced = false;
+    }
+
+    /**
+     * @brief Writer thread work once failed: reports still queued are counted as discarded, and once
+     *        the writes in flight are back the file is cut at the first failed batch.
+     */
+    size_t DropCopyWriter::discard()
+    {
+        size_t done = 0;
+        ExecutionReport report;
+        while (mQueue->TryPop(report)) {
+            bump(mStats.mDiscarded);
+            ++done;
+        }
+        if (mTruncateAt != kNoTruncate && mWritesInFlight == 0 && !mSyncInFlight) {
+            if (ftruncate(mFd, static_cast<off_t>(mTruncateAt)) != 0) {
+                bump(mStats.mErrors); // todo: log
+            }
+            mFileOffset = mTruncateAt;
+            if (mStats.mSyncedBytes.load(std::memory_order_relaxed) > mTruncateAt) {
+                mStats.mSyncedBytes.store(mTruncateAt, std::memory_order_relaxed);
+            }
+            mTruncateAt = kNoTruncate;
+            ++done;
+        }
+        return done;
+    }
+} // namespace OrderEngine
@@ -0,0 +1,163 @@
+#pragma once
+#ifndef DROP_COPY_WRITER_H
+#define DROP_COPY_WRITER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Protocol/ExecutionReport.h"
+#include "../Runtime/Worker.h"
+#include "../Transport/SpscRing.h"
+
+namespace OrderEngine {
+    enum class DropCopyFormat : uint8_t
+    {
+        BINARY, // ExecutionReport records as on the wire, 64 bytes each
+        CSV     // One line per report, after a header line
+    };
+
+    struct DropCopyConfig
+    {
+        DropCopyFormat mFormat = DropCopyFormat::BINARY;
+        size_t mBufferBytes = size_t{1} << 20;      // One batched write, rounded up to whole pages
+        size_t mBufferCount = 8;                    // Batches in flight before the writer waits on the disk
+        uint64_t mFlushIntervalNs = 1'000'000;      // A partly filled batch is written after this long
+        uint64_t mFsyncIntervalNs = 10'000'000;     // fdatasync cadence, 0 syncs after every batch
+        bool mUseIoUring = true;                    // The pwrite thread is used when false or unavailable
+        WorkerConfig mWorker{"dropcopy", -1, false, WaitMode::SPIN_PARK};
+    };
+
+    /**
+     * @struct DropCopyStats
+     * @brief Counters of one drop copy, readable from any thread.
+     * @details
+     * - GetDropped() and mErrors are the ones to alarm on: those reports never reached the file.
+     * - Every counter has a single writer: mDropped the matching thread, the others the writer thread.
+     */
+    struct DropCopyStats
+    {
+        std::atomic<uint64_t> mRecords{0};      // Reports encoded into a batch
+        std::atomic<uint64_t> mBytesWritten{0}; // Bytes the kernel acknowledged
+        std::atomic<uint64_t> mBatches{0};
+        std::atomic<uint64_t> mSyncs{0};
+        std::atomic<uint64_t> mDropped{0};      // Publish found the queue full or the writer failed
+        std::atomic<uint64_t> mDiscarded{0};    // Queued before the writer failed, never written
+        std::atomic<uint64_t> mErrors{0};       // Failed writes and syncs
+        std::atomic<uint64_t> mSyncedBytes{0};  // File prefix a completed fdatasync made durable
+
+        // Reports published but never written, on either side of the queue
+        uint64_t GetDropped() const
+        {
+            return mDropped.load(std::memory_order_relaxed) + mDiscarded.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @class DropCopyWriter
+     * @brief Durable record of every execution report, written off the matching thread.
+     *
+     * @details
+     * - The matcher hands reports to Publish, a push into an SPSC queue: no syscall, no lock,
+     *   no allocation. A full queue is counted as dropped, the matcher never waits on the disk.
+     * - A Worker thread drains the queue into page-aligned batch buffers and submits each full
+     *   batch as one asynchronous write at the end of the file. A partial batch goes out after
+     *   mFlushIntervalNs so a quiet book still reaches the disk.
+     * - Writes go through io_uring when the kernel allows it, otherwise through a second thread
+     *   issuing pwrite. fdatasync runs on the mFsyncIntervalNs cadence, ordered after every
+     *   write submitted before it.
+     * - Close (or the destructor) writes and syncs everything published before it.
+     * - A write or sync that fails for good fails the writer, there is no silent hole: Publish
+     *   refuses every later report (counted as dropped), nothing more is written, and after a
+     *   failed write the file is truncated back to the start of that batch. mSyncedBytes says
+     *   how much of the file is known to be durable.
+     */
+    class DropCopyWriter
+    {
+    public:
+        static constexpr size_t kQueueCapacity = size_t{1} << 16;
+
+        /**
+         * @throws std::runtime_error if the file cannot be created or the buffers allocated
+         */
+        DropCopyWriter(const std::string& path, const DropCopyConfig& config = {});
+        ~DropCopyWriter();
+        DropCopyWriter(const DropCopyWriter&) = delete;
+        DropCopyWriter& operator=(const DropCopyWriter&) = delete;
+
+        // Matching thread only. False, and the report counted as dropped, if the queue is full
+        bool Publish(const ExecutionReport& report)
+        {
+            if (mError.load(std::memory_order_relaxed) == 0 && mQueue->TryPush(report)) {
+                return true;
+            }
+            mStats.mDropped.store(mStats.mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Stops the writer thread once every report published before it is written and synced
+        void Close();
+
+        bool IsUsingIoUring() const;
+        const DropCopyStats& GetStats() const;
+
+        // True once a write or sync failed for good, the file holds nothing published after that
+        bool IsFailed() const;
+        // errno of the failure, 0 while the writer is healthy
+        int GetError() const;
+
+    private:
+        class IoBackend;
+        class UringBackend;
+        class PwriteBackend;
+        static constexpr uint32_t kNoBatch = UINT32_MAX;
+        static constexpr uint64_t kNoTruncate = UINT64_MAX;
+
+        struct Batch
+        {
+            char* mData = nullptr;
+            size_t mLength = 0;     // Bytes to write
+            size_t mWritten = 0;    // Bytes acknowledged so far, short writes are resubmitted
+            uint64_t mOffset = 0;   // File offset of mData[0]
+        };
+
+        int mFd = -1;
+        std::string mPath;
+        DropCopyConfig mConfig;
+        char* mBufferMemory = nullptr;      // Every batch buffer, one page-aligned allocation
+        bool mUsingIoUring = false;
+        std::unique_ptr<SpscRing<ExecutionReport, kQueueCapacity>> mQueue;
+        DropCopyStats mStats;
+
+        // ==== Writer thread state ====
+        std::vector<Batch> mBatches;
+        std::vector<uint32_t> mFreeBatches;
+        uint32_t mCurrent = kNoBatch;       // Batch being filled
+        uint64_t mCurrentStartNs = 0;       // When the current batch got its first record
+        uint64_t mFileOffset = 0;           // End of the data submitted so far
+        uint64_t mSyncOffset = 0;           // End of the data the sync in flight covers
+        uint64_t mTruncateAt = kNoTruncate; // Start of the earliest failed batch
+        size_t mWritesInFlight = 0;
+        bool mSyncInFlight = false;
+        bool mUnsynced = false;             // Writes completed or submitted since the last sync
+        uint64_t mLastSyncNs = 0;
+        std::unique_ptr<IoBackend> mBackend;
+        std::unique_ptr<Worker> mWorker;
+        bool mClosed = false;
+        std::atomic<int> mError{0};
+
+        size_t poll(bool closing);
+        size_t reap();
+        bool ensureRoom();
+        void encode(const ExecutionReport& report);
+        void submitCurrent();
+        void submitWrite(uint32_t batch);
+        void maybeSync(uint64_t now, bool force);
+        void fail(int error);
+        size_t discard();
+    };
+} // namespace OrderEngine
+
+#endif //DROP_COPY_WRITER_H
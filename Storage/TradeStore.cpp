@@ -0,0 +1,263 @@
+#include "TradeStore.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OrderEngine {
+
+    // ==== File layout ====
+    static constexpr size_t kHeaderBytes = 4096;
+    static constexpr size_t kBlockBytes = size_t{4} << 20;  // Two 2MB pages
+    static constexpr size_t kIndexBytes = 4096;
+    static constexpr size_t kRowBytes = sizeof(int64_t) + sizeof(Base::Price) + sizeof(Base::Quantity)
+                                        + 2 * sizeof(Base::OrderId) + sizeof(uint32_t);
+    static constexpr size_t kBlockRows = (kBlockBytes - kIndexBytes) / kRowBytes;
+
+    // Column offsets inside a block, 8-byte columns first so every array stays aligned
+    static constexpr size_t kTimestampOffset = kIndexBytes;
+    static constexpr size_t kPriceOffset = kTimestampOffset + kBlockRows * sizeof(int64_t);
+    static constexpr size_t kQuantityOffset = kPriceOffset + kBlockRows * sizeof(Base::Price);
+    static constexpr size_t kInBoundIdOffset = kQuantityOffset + kBlockRows * sizeof(Base::Quantity);
+    static constexpr size_t kRestingIdOffset = kInBoundIdOffset + kBlockRows * sizeof(Base::OrderId);
+    static constexpr size_t kFlagsOffset = kRestingIdOffset + kBlockRows * sizeof(Base::OrderId);
+    static_assert(kFlagsOffset + kBlockRows * sizeof(uint32_t) <= kBlockBytes, "Columns overflow the block");
+    static_assert(sizeof(TradeStoreHeader) <= kHeaderBytes && sizeof(TradeBlockIndex) <= kIndexBytes, "Header overflow");
+
+    static off_t blockOffset(uint64_t block)
+    {
+        return static_cast<off_t>(kHeaderBytes + block * kBlockBytes);
+    }
+
+    template<typename T> static T* column(char* block, size_t offset)
+    {
+        return reinterpret_cast<T*>(block + offset);
+    }
+
+    static std::runtime_error storeError(const std::string& what, const std::string& path)
+    {
+        return std::runtime_error("TradeStore " + path + ": " + what + " (" + std::strerror(errno) + ")");
+    }
+
+    // ==== Writer ====
+
+    TradeStoreWriter::TradeStoreWriter(const std::string& path, const std::string& symbol)
+        : mPath(path)
+    {
+        mFd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (mFd < 0) {
+            throw storeError("open failed", path);
+        }
+
+        struct stat st{};
+        bool fresh = fstat(mFd, &st) == 0 && st.st_size == 0;
+        if (fresh && ftruncate(mFd, static_cast<off_t>(kHeaderBytes)) != 0) {
+            close(mFd);
+            throw storeError("ftruncate failed", path);
+        }
+
+        void* header = mmap(nullptr, kHeaderBytes, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (header == MAP_FAILED) {
+            close(mFd);
+            throw storeError("mmap failed", path);
+        }
+        mHeader = static_cast<TradeStoreHeader*>(header);
+
+        if (fresh) {
+            new (mHeader) TradeStoreHeader{};
+            mHeader->mVersion = kTradeStoreVersion;
+            mHeader->mBlockRows = static_cast<uint32_t>(kBlockRows);
+            std::strncpy(mHeader->mSymbol, symbol.c_str(), TradeStoreHeader::kSymbolSize - 1);
+            mHeader->mMagic = kTradeStoreMagic;
+        }
+        else if (mHeader->mMagic != kTradeStoreMagic || mHeader->mVersion != kTradeStoreVersion
+                 || mHeader->mBlockRows != kBlockRows) {
+            munmap(mHeader, kHeaderBytes);
+            close(mFd);
+            throw std::runtime_error("TradeStore " + path + ": unexpected layout");
+        }
+
+        // Continue after the last row of an existing file
+        uint64_t blocks = mHeader->mBlockCount.load(std::memory_order_acquire);
+        if (blocks == 0) {
+            mapBlock(0, true);
+        }
+        else {
+            mapBlock(blocks - 1, false);
+            mRowCount = (blocks - 1) * kBlockRows
+                        + reinterpret_cast<TradeBlockIndex*>(mBlock)->mRowCount.load(std::memory_order_relaxed);
+        }
+    }
+
+    TradeStoreWriter::~TradeStoreWriter()
+    {
+        unmapBlock();
+        if (mHeader) {
+            munmap(mHeader, kHeaderBytes);
+        }
+        if (mFd >= 0) {
+            close(mFd);
+        }
+    }
+
+    void TradeStoreWriter::mapBlock(uint64_t blockNumber, bool create)
+    {
+        if (create && ftruncate(mFd, blockOffset(blockNumber + 1)) != 0) {
+            throw storeError("ftruncate failed", mPath);
+        }
+
+        // Pre-faulted, appends to the block never fault
+        void* block = mmap(nullptr, kBlockBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, blockOffset(blockNumber));
+        if (block == MAP_FAILED) {
+            throw storeError("mmap failed", mPath);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(block, kBlockBytes, MADV_HUGEPAGE);
+#endif
+        mBlock = static_cast<char*>(block);
+        mBlockNumber = blockNumber;
+
+        if (create) {
+            new (mBlock) TradeBlockIndex{};
+            mHeader->mBlockCount.store(blockNumber + 1, std::memory_order_release);
+        }
+    }
+
+    void TradeStoreWriter::unmapBlock()
+    {
+        if (mBlock) {
+            munmap(mBlock, kBlockBytes);
+            mBlock = nullptr;
+        }
+    }
+
+    void TradeStoreWriter::Append(const TradeRecord& trade)
+    {
+        auto* index = reinterpret_cast<TradeBlockIndex*>(mBlock);
+        uint64_t row = index->mRowCount.load(std::memory_order_relaxed);
+        if (row == kBlockRows) {
+            unmapBlock();
+            mapBlock(mBlockNumber + 1, true);
+            index = reinterpret_cast<TradeBlockIndex*>(mBlock);
+            row = 0;
+        }
+
+        column<int64_t>(mBlock, kTimestampOffset)[row] = trade.mTimestampNs;
+        column<Base::Price>(mBlock, kPriceOffset)[row] = trade.mPrice;
+        column<Base::Quantity>(mBlock, kQuantityOffset)[row] = trade.mQuantity;
+        column<Base::OrderId>(mBlock, kInBoundIdOffset)[row] = trade.mInBoundOrderId;
+        column<Base::OrderId>(mBlock, kRestingIdOffset)[row] = trade.mRestingOrderId;
+        column<uint32_t>(mBlock, kFlagsOffset)[row] = trade.mFlags;
+
+        if (row == 0) {
+            index->mMinTimestampNs = index->mMaxTimestampNs = trade.mTimestampNs;
+            index->mMinPrice = index->mMaxPrice = trade.mPrice;
+        }
+        else {
+            index->mMinTimestampNs = std::min(index->mMinTimestampNs, trade.mTimestampNs);
+            index->mMaxTimestampNs = std::max(index->mMaxTimestampNs, trade.mTimestampNs);
+            index->mMinPrice = std::min(index->mMinPrice, trade.mPrice);
+            index->mMaxPrice = std::max(index->mMaxPrice, trade.mPrice);
+        }
+        // Publish the row last, readers never see a partial one
+        index->mRowCount.store(row + 1, std::memory_order_release);
+        ++mRowCount;
+    }
+
+    void TradeStoreWriter::Sync()
+    {
+        msync(mHeader, kHeaderBytes, MS_SYNC);
+        if (mBlock) {
+            msync(mBlock, kBlockBytes, MS_SYNC);
+        }
+    }
+
+    uint64_t TradeStoreWriter::GetRowCount() const
+    {
+        return mRowCount;
+    }
+
+    // ==== Reader ====
+
+    TradeStoreReader::TradeStoreReader(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw storeError("open failed", path);
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderBytes) {
+            close(fd);
+            throw std::runtime_error("TradeStore " + path + ": file too small");
+        }
+
+        mSize = static_cast<size_t>(st.st_size);
+        void* base = mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            throw storeError("mmap failed", path);
+        }
+        mBase = static_cast<const char*>(base);
+        // Scans stream through the columns
+        madvise(base, mSize, MADV_SEQUENTIAL);
+
+        const auto* header = reinterpret_cast<const TradeStoreHeader*>(mBase);
+        if (header->mMagic != kTradeStoreMagic || header->mVersion != kTradeStoreVersion || header->mBlockRows != kBlockRows) {
+            munmap(base, mSize);
+            mBase = nullptr;
+            throw std::runtime_error("TradeStore " + path + ": unexpected layout");
+        }
+
+        // Only blocks fully inside the mapping count, the writer may be growing the file
+        mBlockCount = std::min<uint64_t>(header->mBlockCount.load(std::memory_order_acquire),
+                                         (mSize - kHeaderBytes) / kBlockBytes);
+    }
+
+    TradeStoreReader::~TradeStoreReader()
+    {
+        if (mBase) {
+            munmap(const_cast<char*>(mBase), mSize);
+        }
+    }
+
+    std::string TradeStoreReader::GetSymbol() const
+    {
+        const char* symbol = reinterpret_cast<const TradeStoreHeader*>(mBase)->mSymbol;
+        return std::string(symbol, strnlen(symbol, TradeStoreHeader::kSymbolSize));
+    }
+
+    uint64_t TradeStoreReader::GetBlockCount() const
+    {
+        return mBlockCount;
+    }
+
+    uint64_t TradeStoreReader::GetRowCount() const
+    {
+        uint64_t rows = 0;
+        for (uint64_t block = 0; block < mBlockCount; ++block) {
+            rows += GetBlock(block).mRowCount;
+        }
+        return rows;
+    }
+
+    TradeBlockView TradeStoreReader::GetBlock(uint64_t block) const
+    {
+        char* base = const_cast<char*>(mBase) + blockOffset(block);
+        const auto* index = reinterpret_cast<const TradeBlockIndex*>(base);
+        return {index,
+                static_cast<size_t>(index->mRowCount.load(std::memory_order_acquire)),
+                column<int64_t>(base, kTimestampOffset),
+                column<Base::Price>(base, kPriceOffset),
+                column<Base::Quantity>(base, kQuantityOffset),
+                column<Base::OrderId>(base, kInBoundIdOffset),
+                column<Base::OrderId>(base, kRestingIdOffset),
+                column<uint32_t>(base, kFlagsOffset)};
+    }
+} // namespace OrderEngine
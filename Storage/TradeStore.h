@@ -0,0 +1,183 @@
+#pragma once
+#ifndef TRADE_STORE_H
+#define TRADE_STORE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../OrderTypes.h"
+
+namespace OrderEngine {
+    /**
+     * @struct TradeRecord
+     * @brief One persisted execution, the row type of the trade store.
+     */
+    struct TradeRecord
+    {
+        int64_t mTimestampNs;
+        Base::Price mPrice;
+        Base::Quantity mQuantity;
+        uint32_t mFlags;            // Base::FillFlags
+        Base::OrderId mInBoundOrderId;
+        Base::OrderId mRestingOrderId;
+    };
+
+    /**
+     * @brief On-disk layout of a trade store file.
+     *
+     * @details
+     * - One append-only file per symbol: a header page followed by fixed-size blocks.
+     * - Each block starts with a TradeBlockIndex page, then one array per column. Column
+     *   arrays sit at fixed offsets, a scan touches only the columns it reads.
+     * - Block min/max timestamps and prices let range scans skip whole blocks unread.
+     */
+    struct TradeStoreHeader
+    {
+        static constexpr size_t kSymbolSize = 16;
+
+        uint64_t mMagic;
+        uint32_t mVersion;
+        uint32_t mBlockRows;
+        std::atomic<uint64_t> mBlockCount; // Blocks [0, mBlockCount) exist in the file
+        char mSymbol[kSymbolSize];
+    };
+
+    struct TradeBlockIndex
+    {
+        std::atomic<uint64_t> mRowCount; // Rows [0, mRowCount) are written, stored last
+        int64_t mMinTimestampNs;
+        int64_t mMaxTimestampNs;
+        Base::Price mMinPrice;
+        Base::Price mMaxPrice;
+    };
+
+    static constexpr uint64_t kTradeStoreMagic = 0x45524F5453445254ull; // "TRDSTORE"
+    static constexpr uint32_t kTradeStoreVersion = 1;
+
+    /**
+     * @struct TradeBlockView
+     * @brief Column arrays of one block, valid for rows [0, mRowCount).
+     */
+    struct TradeBlockView
+    {
+        const TradeBlockIndex* mIndex;
+        size_t mRowCount;
+        const int64_t* mTimestamps;
+        const Base::Price* mPrices;
+        const Base::Quantity* mQuantities;
+        const Base::OrderId* mInBoundOrderIds;
+        const Base::OrderId* mRestingOrderIds;
+        const uint32_t* mFlags;
+
+        TradeRecord GetRow(size_t row) const
+        {
+            return {mTimestamps[row], mPrices[row], mQuantities[row], mFlags[row], mInBoundOrderIds[row], mRestingOrderIds[row]};
+        }
+    };
+
+    /**
+     * @class TradeStoreWriter
+     * @brief Appends executions of one symbol to its trade store file through a mmap'd block.
+     *
+     * @details
+     * - The current block is mapped shared and pre-faulted, appends are plain stores, no syscalls.
+     *   Blocks are 4MB and hugepage aligned, the mapping asks for transparent hugepages.
+     * - A full block is unmapped and the file grows by one block, the only syscalls on the path.
+     * - Reopening an existing file continues appending after its last row.
+     * - Single writer. Readers may map the file at any time, they see whole rows only.
+     */
+    class TradeStoreWriter
+    {
+    public:
+        /**
+         * @throws std::runtime_error if the file cannot be created, mapped or has an unexpected layout
+         */
+        TradeStoreWriter(const std::string& path, const std::string& symbol);
+        ~TradeStoreWriter();
+        TradeStoreWriter(const TradeStoreWriter&) = delete;
+        TradeStoreWriter& operator=(const TradeStoreWriter&) = delete;
+
+        void Append(const TradeRecord& trade);
+
+        // Flushes the mapped pages to the file (msync), not needed for readers on the same host
+        void Sync();
+
+        uint64_t GetRowCount() const;
+
+    private:
+        int mFd = -1;
+        std::string mPath;
+        TradeStoreHeader* mHeader = nullptr;
+        char* mBlock = nullptr;     // Current block mapping
+        uint64_t mBlockNumber = 0;
+        uint64_t mRowCount = 0;     // Rows across all blocks
+
+        void mapBlock(uint64_t blockNumber, bool create);
+        void unmapBlock();
+    };
+
+    /**
+     * @class TradeStoreReader
+     * @brief Read-only mapping of a trade store file with block-skipping range scans.
+     */
+    class TradeStoreReader
+    {
+    public:
+        /**
+         * @throws std::runtime_error if the file cannot be mapped or has an unexpected layout
+         */
+        explicit TradeStoreReader(const std::string& path);
+        ~TradeStoreReader();
+        TradeStoreReader(const TradeStoreReader&) = delete;
+        TradeStoreReader& operator=(const TradeStoreReader&) = delete;
+
+        std::string GetSymbol() const;
+        uint64_t GetBlockCount() const;
+        uint64_t GetRowCount() const;
+        TradeBlockView GetBlock(uint64_t block) const;
+
+        /**
+         * @brief Calls fn(const TradeBlockView&, size_t beginRow, size_t endRow) for every block that
+         *        may hold trades in [fromNs, toNs], skipping the others on their index alone.
+         * @details Rows of a block are in append order; rows outside the range inside a visited
+         *          block are left for fn to filter, which keeps the inner loop a straight column scan.
+         * @return Number of blocks visited
+         */
+        template<typename Fn> uint64_t ScanBlocks(int64_t fromNs, int64_t toNs, Fn&& fn) const
+        {
+            uint64_t visited = 0;
+            for (uint64_t block = 0; block < mBlockCount; ++block) {
+                TradeBlockView view = GetBlock(block);
+                if (view.mRowCount == 0 || view.mIndex->mMaxTimestampNs < fromNs || view.mIndex->mMinTimestampNs > toNs) {
+                    continue;
+                }
+                fn(view, size_t{0}, view.mRowCount);
+                ++visited;
+            }
+            return visited;
+        }
+
+        // Calls fn(const TradeRecord&) for every trade with a timestamp in [fromNs, toNs]
+        template<typename Fn> uint64_t ForEach(int64_t fromNs, int64_t toNs, Fn&& fn) const
+        {
+            uint64_t matched = 0;
+            ScanBlocks(fromNs, toNs, [&](const TradeBlockView& view, size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    if (view.mTimestamps[row] >= fromNs && view.mTimestamps[row] <= toNs) {
+                        fn(view.GetRow(row));
+                        ++matched;
+                    }
+                }
+            });
+            return matched;
+        }
+
+    private:
+        const char* mBase = nullptr;
+        size_t mSize = 0;
+        uint64_t mBlockCount = 0;   // Blocks present when the file was mapped
+    };
+} // namespace OrderEngine
+
+#endif //TRADE_STORE_H
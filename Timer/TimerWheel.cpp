@@ -0,0 +1,170 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+namespace OrderEngine {
+
+    TimerWheel::TimerWheel(uint64_t currentTick, Arena* arena)
+        : mNodes(ArenaAllocator<Node>(arena)),
+          mCurrentTick(currentTick)
+    {
+        mSlotHeads.fill(kNil);
+    }
+
+    void TimerWheel::Start(uint64_t currentTick)
+    {
+        if (mCurrentTick == kNotStarted && currentTick != kNotStarted) {
+            mCurrentTick = currentTick;
+        }
+    }
+
+    bool TimerWheel::IsStarted() const
+    {
+        return mCurrentTick != kNotStarted;
+    }
+
+    void TimerWheel::Reserve(size_t timers)
+    {
+        mNodes.reserve(timers);
+    }
+
+    TimerWheel::TimerId TimerWheel::Arm(uint64_t deadlineTick, uint64_t payload)
+    {
+        if (!IsStarted()) {
+            return kNoTimer; // todo: log, the owner starts the wheel before arming
+        }
+
+        uint32_t nodeIdx;
+        if (mFreeHead != kNil) {
+            nodeIdx = mFreeHead;
+            mFreeHead = mNodes[nodeIdx].mNext;
+        }
+        else {
+            nodeIdx = static_cast<uint32_t>(mNodes.size());
+            mNodes.emplace_back();
+        }
+
+        Node& node = mNodes[nodeIdx];
+        node.mDeadline = deadlineTick;
+        node.mPayload = payload;
+        insert(nodeIdx);
+        ++mArmedCount;
+        return nodeIdx;
+    }
+
+    void TimerWheel::Disarm(TimerId id)
+    {
+        if (id >= mNodes.size() || mNodes[id].mSlot == kNil) {
+            return;
+        }
+        unlink(id);
+        mNodes[id].mNext = mFreeHead;
+        mFreeHead = id;
+        --mArmedCount;
+    }
+
+    void TimerWheel::Advance(uint64_t nowTick, std::vector<uint64_t>& expired)
+    {
+        Start(nowTick);
+        if (mArmedCount == 0) {
+            // Nothing to fire or cascade, jump straight to now
+            mCurrentTick = std::max(mCurrentTick, nowTick);
+            return;
+        }
+
+        while (mCurrentTick < nowTick && mArmedCount > 0) {
+            ++mCurrentTick;
+
+            // Refill the lower wheels from the levels above whenever they wrap
+            for (uint32_t level = 1; level < kLevels; ++level) {
+                if ((mCurrentTick >> (kSlotBits * (level - 1))) & kSlotMask) {
+                    break;
+                }
+                cascade(level);
+            }
+
+            uint32_t& head = mSlotHeads[mCurrentTick & kSlotMask];
+            while (head != kNil) {
+                uint32_t nodeIdx = head;
+                Node& node = mNodes[nodeIdx];
+                unlink(nodeIdx);
+                expired.push_back(node.mPayload);
+                node.mNext = mFreeHead;
+                mFreeHead = nodeIdx;
+                --mArmedCount;
+            }
+        }
+
+        mCurrentTick = std::max(mCurrentTick, nowTick);
+    }
+
+    uint64_t TimerWheel::GetCurrentTick() const
+    {
+        return mCurrentTick;
+    }
+
+    size_t TimerWheel::GetArmedCount() const
+    {
+        return mArmedCount;
+    }
+
+    void TimerWheel::insert(uint32_t nodeIdx)
+    {
+        Node& node = mNodes[nodeIdx];
+
+        // Overdue timers go to the next tick, far ones are parked at the top level's horizon
+        constexpr uint64_t horizon = (uint64_t{1} << (kSlotBits * kLevels)) - 1;
+        uint64_t deadline = std::max(node.mDeadline, mCurrentTick + 1);
+        uint64_t delta = std::min(deadline - mCurrentTick, horizon);
+        deadline = mCurrentTick + delta;
+
+        uint32_t level = 0;
+        while (level + 1 < kLevels && delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        uint32_t slot = level * kSlots + static_cast<uint32_t>((deadline >> (kSlotBits * level)) & kSlotMask);
+
+        node.mSlot = slot;
+        node.mPrev = kNil;
+        node.mNext = mSlotHeads[slot];
+        if (node.mNext != kNil) {
+            mNodes[node.mNext].mPrev = nodeIdx;
+        }
+        mSlotHeads[slot] = nodeIdx;
+    }
+
+    void TimerWheel::unlink(uint32_t nodeIdx)
+    {
+        Node& node = mNodes[nodeIdx];
+        if (node.mPrev != kNil) {
+            mNodes[node.mPrev].mNext = node.mNext;
+        }
+        else {
+            mSlotHeads[node.mSlot] = node.mNext;
+        }
+        if (node.mNext != kNil) {
+            mNodes[node.mNext].mPrev = node.mPrev;
+        }
+        node.mPrev = kNil;
+        node.mNext = kNil;
+        node.mSlot = kNil;
+    }
+
+    /**
+     * @brief Re-files the timers of the level's current slot into the levels below.
+     * @details The slot is detached first, so a timer that still belongs to this level
+     *          (parked beyond the horizon) is simply filed again.
+     */
+    void TimerWheel::cascade(uint32_t level)
+    {
+        uint32_t slot = level * kSlots + static_cast<uint32_t>((mCurrentTick >> (kSlotBits * level)) & kSlotMask);
+        uint32_t nodeIdx = mSlotHeads[slot];
+        mSlotHeads[slot] = kNil;
+
+        while (nodeIdx != kNil) {
+            uint32_t next = mNodes[nodeIdx].mNext;
+            insert(nodeIdx);
+            nodeIdx = next;
+        }
+    }
+} // namespace OrderEngine
@@ -0,0 +1,97 @@
+#pragma once
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Memory/Arena.h"
+
+namespace OrderEngine {
+    /**
+     * @class TimerWheel
+     * @brief Hierarchical timing wheel for order expiry.
+     *
+     * @details
+     * - Time is measured in ticks, the caller decides what a tick is (the book uses 1ms).
+     * - kLevels wheels of kSlots slots each, level L slots are kSlots^L ticks wide. A timer
+     *   lands on the lowest level whose span covers its distance, and is cascaded down a
+     *   level each time the wheel below it wraps around.
+     * - Timers live in a node pool and are chained into their slot with index links, so
+     *   Arm and Disarm are O(1) and reuse freed nodes.
+     * - Advance() runs on the owning thread and returns every due payload in one batch.
+     * - A wheel built without a tick starts at the first time it is given, by Start() or the
+     *   first Advance(). Its timers then depend only on the times passed in, never on when it
+     *   was built. Deadlines are not times: Arm() never starts or moves the wheel.
+     *
+     * Example (kSlots = 64, 1ms ticks):
+     * - Level 0: next 64ms, one slot per tick
+     * - Level 1: next ~4s, one slot per 64ms
+     * - Level 4: up to ~12 days, timers further out are parked in the farthest slot
+     */
+    class TimerWheel
+    {
+    public:
+        using TimerId = uint32_t;
+        static constexpr TimerId kNoTimer = UINT32_MAX;
+        static constexpr uint64_t kNotStarted = UINT64_MAX;
+
+        explicit TimerWheel(uint64_t currentTick = kNotStarted, Arena* arena = nullptr);
+
+        // Starts the wheel at currentTick, ignored once it has started
+        void Start(uint64_t currentTick);
+        bool IsStarted() const;
+
+        // Sizes the node pool for timers armed at once, Arm then only reuses nodes below that
+        void Reserve(size_t timers);
+
+        /**
+         * @brief Arms a timer firing at deadlineTick.
+         * @details A deadline at or before the current tick fires on the next Advance().
+         * @param payload Returned by Advance() when the timer fires (e.g. an order id)
+         * @return kNoTimer if the wheel has not been started
+         */
+        TimerId Arm(uint64_t deadlineTick, uint64_t payload);
+
+        // Cancels an armed timer, unknown or already fired ids are ignored
+        void Disarm(TimerId id);
+
+        /**
+         * @brief Moves the wheel to nowTick and collects the payloads of all due timers.
+         * @details Payloads are appended to expired, fired timers are released.
+         */
+        void Advance(uint64_t nowTick, std::vector<uint64_t>& expired);
+
+        uint64_t GetCurrentTick() const;
+        size_t GetArmedCount() const;
+
+    private:
+        static constexpr uint32_t kSlotBits = 6;
+        static constexpr uint32_t kSlots = 1u << kSlotBits;
+        static constexpr uint32_t kSlotMask = kSlots - 1;
+        static constexpr uint32_t kLevels = 5;
+        static constexpr uint32_t kNil = UINT32_MAX;
+
+        struct Node
+        {
+            uint64_t mDeadline{};
+            uint64_t mPayload{};
+            uint32_t mPrev{kNil};
+            uint32_t mNext{kNil};
+            uint32_t mSlot{kNil}; // level * kSlots + slot, kNil when free
+        };
+
+        std::vector<Node, ArenaAllocator<Node>> mNodes;
+        uint32_t mFreeHead = kNil;
+        std::array<uint32_t, kLevels * kSlots> mSlotHeads;
+        uint64_t mCurrentTick;
+        size_t mArmedCount = 0;
+
+        void insert(uint32_t nodeIdx);
+        void unlink(uint32_t nodeIdx);
+        void cascade(uint32_t level);
+    };
+} // namespace OrderEngine
+
+#endif //TIMER_WHEEL_H
@@ -0,0 +1,156 @@
+#pragma once
+#ifndef MPSC_SEQUENCER_H
+#define MPSC_SEQUENCER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace OrderEngine {
+    /**
+     * @class MpscSequencer
+     * @brief Bounded multi-producer/single-consumer ring that puts messages in one global order.
+     *
+     * @details
+     * - A producer claims the next sequence with a CAS on the claim cursor, writes its slot and
+     *   publishes it with a release store of the slot's turn. Producers only ever race on the
+     *   claim cursor; a producer that loses retries at once, none waits for another to finish.
+     * - Sequences start at 1 and have no gaps. The consumer delivers strictly in sequence order,
+     *   so a claimed but not yet published slot holds back the ones behind it.
+     * - Each message is stamped with its sequence and arrival time (steady clock, ns) when it is
+     *   claimed. Arrival times are made non-decreasing on delivery: a later claim can read the
+     *   clock first, its stamp is raised to the previous one.
+     * - The sequence is the single ordering of the engine's input: journal records, replication
+     *   checkpoints and market data gap checks all count in it.
+     * - Same placement rules as SpscRing, it can live in a shared memory mapping.
+     */
+    template<typename T, size_t Capacity> class MpscSequencer
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "Messages are copied as raw bytes");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indexes must be usable from shared memory");
+
+    public:
+        struct Entry
+        {
+            uint64_t mSequence;
+            uint64_t mArrivalNs;
+            T mMessage;
+        };
+
+        MpscSequencer()
+        {
+            for (size_t i = 0; i < Capacity; ++i) {
+                mSlots[i].mTurn.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Sequences and publishes one message, safe from any number of threads.
+         * @return The message's sequence, 0 if the ring is full
+         */
+        uint64_t TryPublish(const T& message)
+        {
+            uint64_t position = mClaim.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = mSlots[position & kMask];
+                uint64_t turn = slot.mTurn.load(std::memory_order_acquire);
+                auto lag = static_cast<int64_t>(turn - position);
+                if (lag == 0) {
+                    if (mClaim.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.mEntry.mSequence = position + 1;
+                        slot.mEntry.mArrivalNs = nowNs();
+                        slot.mEntry.mMessage = message;
+                        slot.mTurn.store(position + 1, std::memory_order_release);
+                        return position + 1;
+                    }
+                    // Lost the claim, position now holds the current cursor
+                }
+                else if (lag < 0) {
+                    return 0; // Full, the consumer has not released this slot yet
+                }
+                else {
+                    position = mClaim.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Next entry in sequence order, false if it is not published yet. Consumer only.
+        bool TryPop(Entry& entry)
+        {
+            uint64_t next = mNext.load(std::memory_order_relaxed);
+            Slot& slot = mSlots[next & kMask];
+            if (slot.mTurn.load(std::memory_order_acquire) != next + 1) {
+                return false;
+            }
+            entry = slot.mEntry;
+            slot.mTurn.store(next + Capacity, std::memory_order_release);
+            mNext.store(next + 1, std::memory_order_relaxed);
+
+            if (entry.mArrivalNs < mLastArrivalNs) {
+                entry.mArrivalNs = mLastArrivalNs;
+            }
+            mLastArrivalNs = entry.mArrivalNs;
+            return true;
+        }
+
+        /**
+         * @brief Hands up to maxEntries entries to handler in sequence order, returns how many.
+         * @details The consumer routes each entry to its shard from handler.
+         */
+        template<typename Handler> size_t Drain(Handler&& handler, size_t maxEntries)
+        {
+            Entry entry;
+            size_t drained = 0;
+            while (drained < maxEntries && TryPop(entry)) {
+                handler(static_cast<const Entry&>(entry));
+                ++drained;
+            }
+            return drained;
+        }
+
+        // Claimed but not yet delivered, includes slots still being written
+        size_t Size() const
+        {
+            return mClaim.load(std::memory_order_acquire) - mNext.load(std::memory_order_acquire);
+        }
+
+        // Sequence of the last delivered entry, 0 before the first
+        uint64_t GetDeliveredSequence() const
+        {
+            return mNext.load(std::memory_order_acquire);
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr uint64_t kMask = Capacity - 1;
+
+        // mTurn == position: free for the producer claiming position
+        // mTurn == position + 1: published, ready for the consumer
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> mTurn;
+            Entry mEntry;
+        };
+
+        static uint64_t nowNs()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // Producers
+        alignas(64) std::atomic<uint64_t> mClaim{0};
+
+        // Consumer
+        alignas(64) std::atomic<uint64_t> mNext{0};
+        uint64_t mLastArrivalNs = 0;
+
+        Slot mSlots[Capacity];
+    };
+} // namespace OrderEngine
+
+#endif //MPSC_SEQUENCER_H
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace OrderEngine {
+    /**
+     * @class SpscRing
+     * @brief Bounded single-producer/single-consumer ring of fixed-size messages.
+     *
+     * @details
+     * - Self-contained and position independent, it can be placed (placement new) in a shared
+     *   memory mapping and used between threads or processes.
+     * - Head and tail live on separate cache lines. Each side also keeps a cached copy of the
+     *   other side's index, so it only reads the shared index when the ring looks full/empty.
+     * - TryPush/TryPop never block, callers decide how to wait.
+     */
+    template<typename T, size_t Capacity> class SpscRing
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "Messages are copied as raw bytes");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indexes must be usable from shared memory");
+
+    public:
+        bool TryPush(const T& message)
+        {
+            uint64_t head = mHead.load(std::memory_order_relaxed);
+            if (head - mCachedTail == Capacity) {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                if (head - mCachedTail == Capacity) {
+                    return false; // Full
+                }
+            }
+            mSlots[head & kMask] = message;
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T& message)
+        {
+            uint64_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail == mCachedHead) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                if (tail == mCachedHead) {
+                    return false; // Empty
+                }
+            }
+            message = mSlots[tail & kMask];
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t Size() const
+        {
+            return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+
+    private:
+        static constexpr uint64_t kMask = Capacity - 1;
+
+        // Producer side
+        alignas(64) std::atomic<uint64_t> mHead{0};
+        uint64_t mCachedTail = 0;
+
+        // Consumer side
+        alignas(64) std::atomic<uint64_t> mTail{0};
+        uint64_t mCachedHead = 0;
+
+        alignas(64) T mSlots[Capacity];
+    };
+} // namespace OrderEngine
+
+#endif //SPSC_RING_H